@@ -24,18 +24,43 @@
 
 namespace e2d {
 
-    std::map<std::string, size_t> config_t::cmdIntArgs = {};
-    std::map<std::string, std::string> config_t::cmdStrArgs = {};
+    std::map<std::string, size_t> config_t::cmdIntArgs = { {"--mem-limit", 0}, {"--rows", 0}, {"--serve-http", 0}};
+    std::map<std::string, std::string> config_t::cmdStrArgs = { {"--include-module", ""}, {"--exclude-module", ""}, {"--include-op", ""}, {"--exclude-op", ""}, {"--include-type", ""}, {
+            "--exclude-type", ""}, {"--style", ""}, {"-s", ""}, {"--trace", ""}, {"-t", ""}, {"--format", ""}, {"-f", ""}, {"--output", ""}, {"-o", ""}, {"--cache-dir", ""}, {"--memory-profile", ""}, {"--cluster-by", ""}};
     std::map<std::string, bool> config_t::cmdBoolArgs = { {"--help", false}, {"-h", false}, {"-?", false}, {"--exclude-mvc", false}, {"-m", false}, {"--compact", false}, {"-c", false}, {
-            "--exclude-result", false}, {"-r", false}};
+            "--exclude-result", false}, {"-r", false}, {"--prune", false}, {"-p", false}, {"--fingerprint", false}, {
+            "--mask-literals", false}};
     std::map<std::string, typename config_t::cmdargtype_t> config_t::cmdArgTypes = { {"--help", argbool}, {"-h", argbool}, {"-?", argbool}, {"--exclude-mvc", argbool}, {"-m", argbool}, {"--compact",
-            argbool}, {"-c", argbool}};
+            argbool}, {"-c", argbool}, {"--exclude-result", argbool}, {"-r", argbool}, {"--prune", argbool}, {"-p", argbool}, {"--include-module", argstr}, {"--exclude-module", argstr}, {
+            "--include-op", argstr}, {"--exclude-op", argstr}, {"--include-type", argstr}, {"--exclude-type", argstr}, {"--style", argstr}, {"-s",
+            argstr}, {"--trace", argstr}, {"-t", argstr}, {"--mem-limit", argint}, {"--format", argstr}, {"-f", argstr}, {"--output", argstr}, {"-o", argstr}, {
+            "--fingerprint", argbool}, {"--mask-literals", argbool}, {"--cache-dir", argstr}, {"--memory-profile", argstr}, {"--rows",
+            argint}, {"--serve-http", argint}, {"--cluster-by", argstr}};
 
     config_t::config_t()
             : HELP(),
               EXCLUDE_MVC(),
               COMPACT(),
-              EXCLUDE_RESULT() {
+              EXCLUDE_RESULT(),
+              PRUNE(),
+              INCLUDE_MODULE(),
+              EXCLUDE_MODULE(),
+              INCLUDE_OP(),
+              EXCLUDE_OP(),
+              INCLUDE_TYPE(),
+              EXCLUDE_TYPE(),
+              STYLE_FILE(),
+              TRACE_FILE(),
+              MEM_LIMIT(),
+              FORMAT(),
+              OUTPUT(),
+              FINGERPRINT(),
+              MASK_LITERALS(),
+              CACHE_DIR(),
+              MEMORY_PROFILE(),
+              ROWS(),
+              SERVE_HTTP(),
+              CLUSTER_BY() {
         update();
     }
 
@@ -128,6 +153,25 @@ namespace e2d {
         HELP = cmdBoolArgs["--help"] | cmdBoolArgs["-h"] | cmdBoolArgs["-?"];
         COMPACT = cmdBoolArgs["--compact"] | cmdBoolArgs["-c"];
         EXCLUDE_RESULT = cmdBoolArgs["--exclude-result"] | cmdBoolArgs["-r"];
+        PRUNE = cmdBoolArgs["--prune"] | cmdBoolArgs["-p"];
+        INCLUDE_MODULE = cmdStrArgs["--include-module"];
+        EXCLUDE_MODULE = cmdStrArgs["--exclude-module"];
+        INCLUDE_OP = cmdStrArgs["--include-op"];
+        EXCLUDE_OP = cmdStrArgs["--exclude-op"];
+        INCLUDE_TYPE = cmdStrArgs["--include-type"];
+        EXCLUDE_TYPE = cmdStrArgs["--exclude-type"];
+        STYLE_FILE = cmdStrArgs["--style"].size() ? cmdStrArgs["--style"] : cmdStrArgs["-s"];
+        TRACE_FILE = cmdStrArgs["--trace"].size() ? cmdStrArgs["--trace"] : cmdStrArgs["-t"];
+        MEM_LIMIT = cmdIntArgs["--mem-limit"];
+        FORMAT = cmdStrArgs["--format"].size() ? cmdStrArgs["--format"] : cmdStrArgs["-f"];
+        OUTPUT = cmdStrArgs["--output"].size() ? cmdStrArgs["--output"] : cmdStrArgs["-o"];
+        FINGERPRINT = cmdBoolArgs["--fingerprint"];
+        MASK_LITERALS = cmdBoolArgs["--mask-literals"];
+        CACHE_DIR = cmdStrArgs["--cache-dir"];
+        MEMORY_PROFILE = cmdStrArgs["--memory-profile"];
+        ROWS = cmdIntArgs["--rows"];
+        SERVE_HTTP = cmdIntArgs["--serve-http"];
+        CLUSTER_BY = cmdStrArgs["--cluster-by"];
     }
 
 }
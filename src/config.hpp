@@ -69,6 +69,25 @@ namespace e2d {
         bool EXCLUDE_MVC;
         bool COMPACT;
         bool EXCLUDE_RESULT;
+        bool PRUNE;
+        std::string INCLUDE_MODULE;
+        std::string EXCLUDE_MODULE;
+        std::string INCLUDE_OP;
+        std::string EXCLUDE_OP;
+        std::string INCLUDE_TYPE;
+        std::string EXCLUDE_TYPE;
+        std::string STYLE_FILE;
+        std::string TRACE_FILE;
+        size_t MEM_LIMIT;
+        std::string FORMAT;
+        std::string OUTPUT;
+        bool FINGERPRINT;
+        bool MASK_LITERALS;
+        std::string CACHE_DIR;
+        std::string MEMORY_PROFILE;
+        size_t ROWS;
+        size_t SERVE_HTTP;
+        std::string CLUSTER_BY;
 
         config_t();
 
@@ -1,185 +1,64 @@
 #include <iostream>
+#include <fstream>
 #include <iomanip>
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <memory>
 #include <algorithm>
 #include <cctype>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/iostreams/device/mapped_file.hpp>
 
 #include "common.hpp"
 #include "config.hpp"
+#include "graph.hpp"
+#include "filter.hpp"
+#include "trace.hpp"
+#include "style.hpp"
+#include "mal.hpp"
+#include "extmem.hpp"
+#include "output.hpp"
+#include "fingerprint.hpp"
+#include "memprofile.hpp"
+#include "server.hpp"
 
 namespace e2d {
 
 ///////////////////////////////
 // EXPLAINED-2-DOT           //
 ///////////////////////////////
-    const char* const FIND_ROOT = "function ";
-    const size_t FIND_ROOT_LEN = strlen(FIND_ROOT);
-    const char* const FIND_BARRIER = "barrier";
-    const char* const FIND_ROOT_OPTIONS = "{";
-    const char* const FIND_ROOT_OPTIONS_END = "}";
-    const char* const FIND_ROOT_VARS = "(";
-    const char* const FIND_ROOT_VARS_END = ")";
-    const char* const FIND_SQL_MVC = "sql.mvc";
-    const char* const SQL_ASSIGN = " := ";
-    const size_t SQL_ASSIGN_LEN = strlen(SQL_ASSIGN);
-    const char* const SQL_RESULT_SET = "sql.resultSet";
-    const std::list<std::string> IGNORED_NAMES = {"nil", "true", "false"};
-    const std::list<std::string> IGNORED_OPERATORS = {"querylog.define", "language.dataflow", "language.pass"};
-    const std::list<std::string> IGNORED_LINES_BEGINS = {"+", "mal", "barrier ", "exit ", "end "};
-    const std::map<std::string, std::string> COLORIZE_BG_PREFIX = { {"algebra", "cyan"}, {"aggr", "green"}, {"batcalc", "gold"}, {"group", "orangered"}, {"sql", "gainsboro"}, {"bat", "peachpuff"}};
-    const std::map<std::string, std::string> COLORIZE_FG_PREFIX = { {"group", "white"}};
-
-    bool is_number(
-            const std::string& s) {
-        return !s.empty() && find_if(s.begin(), s.end(), [](char c) {
-            return !isdigit(c);}) == s.end();
-    }
-
-    bool ignore(
-            std::string& name) {
-        return ((boost::starts_with(name, "\"") && boost::ends_with(name, "\"")) || (boost::starts_with(name, "'") && boost::ends_with(name, "'"))
-                || (find(IGNORED_NAMES.begin(), IGNORED_NAMES.end(), name) != IGNORED_NAMES.end()) || is_number(name));
-    }
-
-    const id_t INVALID_ID = static_cast<id_t>(-1);
-
-    id_t nextID() {
-        static id_t id = 0;
-        return id++;
-    }
-
-    std::map<id_t, std::string> idsToNames;
-    std::map<std::string, id_t> namesToIDs;
-    std::map<id_t, std::string> idType;
-
-    std::list<id_t> nodes;
-    std::multimap<id_t, id_t> nodeIn;
-    std::multimap<id_t, id_t> nodeOut;
-    std::map<id_t, id_t> reassign;
-    std::list<id_t> values;
-    std::map<id_t, id_t> valueAssign;
-
-/// FROM HERE taken from the answer from
-/// http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring
-    const char* const TRIM_CHARS = " \t\n\r\f\v |:";
-
-// trim from end of string (right)
-
-    inline std::string& rtrim(
-            std::string& s,
-            const char* t = TRIM_CHARS) {
-        s.erase(s.find_last_not_of(t) + 1);
-        return s;
-    }
-
-// trim from beginning of string (left)
-
-    inline std::string& ltrim(
-            std::string& s,
-            const char* t = TRIM_CHARS) {
-        s.erase(0, s.find_first_not_of(t));
-        return s;
-    }
-
-// trim from both ends of string (left & right)
-
-    inline std::string& trim(
-            std::string& s,
-            const char* t = TRIM_CHARS) {
-        return ltrim(rtrim(s, t), t);
-    }
-/// UNTIL HERE
-    const char* const TRIM_ARGS = " \t\n\r\f\v |;";
-
-    std::string& replaceInString(
-            std::string& s,
-            char src,
-            char dest) {
-        if (src != dest) {
-            size_t pos = s.find(src);
-            while (pos != std::string::npos) {
-                s.replace(pos, 1, 1, dest);
-                pos = s.find(src, pos);
-            }
-        }
-        return s;
-    }
-
     size_t parse(
             id_t nodeID,
             std::string& s,
             bool isIn,
             size_t line) {
-        size_t beg = 0, pos = 0, pos2 = 0, pos3 = 0;
-        std::string name, type;
-        bool hasType;
-        if (s[0] == '(') {
-            pos2 = std::string::npos;
-            beg = 1;
-            do {
-                if (s[beg] == ')') {
-                    break;
-                } else if (s[beg] == ',') {
-                    ++beg;
-                }
-                hasType = false;
-                pos2 = s.find(',', beg);
-                pos = s.find(':', beg);
-                if (pos == std::string::npos && pos2 == std::string::npos) { // Simple type remaining
-                    name = s.substr(beg, s.size() - beg - 1);
-                } else if (pos < pos2) { // Type information
-                    name = s.substr(beg, pos - beg);
-                    pos3 = s.find('[', pos);
-                    hasType = true;
-                    if (pos3 < pos2) { // bat or other composite type
-                        pos2 = s.find(']', pos3);
-                        PRINT_ERROR_ON(pos2 == std::string::npos, "Did not find finalizing ']' on line " << line, __LINE__);
-                        type = s.substr(pos + 1, pos2 - pos); // the whole bat type
-                    } else { // Simple type with type information
-                        type = s.substr(pos + 1, (pos2 == std::string::npos) ? (s.size() - pos - 2) : (pos2 - pos - 1));
-                    }
-                } else { // Simple type without type information
-                    name = s.substr(beg, pos2 - beg);
-                }
-                trim(name);
-                if (!::e2d::ignore(name)) {
-                    if (isIn) {
-                        auto iter = namesToIDs.find(name);
-                        PRINT_ERROR_ON(iter == namesToIDs.end(), "No ID for name \"" << name << '"', __LINE__);
-                        nodeIn.insert(std::make_pair(nodeID, iter->second)); // nodeIn[nodeID].push_back(iter->second);
-                    } else {
-                        id_t id = nextID();
-                        idsToNames[id] = name;
-                        namesToIDs[name] = id;
-                        if (hasType) {
-                            idType[id] = type;
-                        }
-                        nodeOut.insert(std::make_pair(nodeID, id)); //nodeOut[nodeID].push_back(id);
-                    }
+        size_t position = 0;
+        return parseVars(s, line, [&](const std::string& name, bool hasType, const std::string& type) -> size_t {
+            ++position;
+            if (isIn) {
+                auto iter = namesToIDs.find(name);
+                PRINT_ERROR_ON(iter == namesToIDs.end(), "No ID for name \"" << name << '"', __LINE__);
+                nodeIn.insert(std::make_pair(nodeID, iter->second)); // nodeIn[nodeID].push_back(iter->second);
+            } else {
+                id_t id = nextID();
+                idsToNames[id] = name;
+                namesToIDs[name] = id;
+                if (hasType) {
+                    idType[id] = type;
                 }
-                beg = pos2 == std::string::npos ? std::string::npos : pos2 + 1;
-            } while ((beg != std::string::npos) && ((pos != std::string::npos) || (pos2 != std::string::npos)));
-        } else {
-            pos = s.find(':');
-            id_t id = nextID();
-            name = s.substr(0, pos);
-            trim(name);
-            idsToNames[id] = name;
-            namesToIDs[name] = id;
-            if (pos != std::string::npos) { // type information
-                idType[id] = s.substr(pos + 1);
+                nodeOut.insert(std::make_pair(nodeID, id)); //nodeOut[nodeID].push_back(id);
             }
-            // isIn ? nodeIn[nodeID].push_back(id) : nodeOut[nodeID].push_back(id);
-            isIn ? nodeIn.insert(std::make_pair(nodeID, id)) : nodeOut.insert(std::make_pair(nodeID, id));
-        }
-        return 0;
+            return 0;
+        }, [&](const std::string& literal, bool hasType, const std::string& type) {
+            if (isIn) {
+                nodeLiterals.insert(std::make_pair(nodeID, std::make_pair(position, hasType ? literal + ':' + type : literal)));
+            }
+            ++position;
+        });
     }
 
     int main(
@@ -200,101 +79,107 @@ namespace e2d {
         ///////////////////////
         if (argc == 1 || CONFIG.HELP) {
             boost::filesystem::path p(argv[0]);
-            std::cerr << "Usage: " << p.filename() << " [-?|-h|--help] [--exclude-mvc|-m] [--compact|-c] [--exclude-result|-r] <explained file>\n";
+            std::cerr << "Usage: " << p.filename() << " [-?|-h|--help] [--exclude-mvc|-m] [--compact|-c] [--exclude-result|-r] [--prune|-p] [--include-module <list>] [--exclude-module <list>]"
+                    " [--include-op <regex>] [--exclude-op <regex>] [--include-type <list>] [--exclude-type <list>] [--style|-s <file>] [--trace|-t <file>]"
+                    " [--mem-limit <MiB>] [--format|-f dot|json|graphml] [--output|-o <file>] [--fingerprint] [--mask-literals] [--cache-dir <dir>]"
+                    " [--memory-profile <file>] [--rows <n>] [--serve-http <port>] [--cluster-by module|barrier] <explained file>\n";
             std::cerr << "\tDesigned for MonetDB!\n";
             std::cerr << "\t-?|-h|--help                  Display this help.\n";
             std::cerr << "\t--exclude-mvc|-m              Do not include the starting mvc node, its result, and respective edges in the graph.\n";
             std::cerr << "\t--compact|-c                  Generate a very compact graph.\n";
             std::cerr << "\t--exclude-result|-r           Exclude SQL result set and its descriptor BATs.\n";
+            std::cerr << "\t--prune|-p                    Also exclude all nodes whose results no longer reach any included node.\n";
+            std::cerr << "\t--include-module <list>       Only include nodes of the given comma-separated modules (e.g. \"algebra,aggr\").\n";
+            std::cerr << "\t--exclude-module <list>       Exclude nodes of the given comma-separated modules.\n";
+            std::cerr << "\t--include-op <regex>          Only include nodes whose operator name (e.g. \"algebra.thetaselect\") matches the regex.\n";
+            std::cerr << "\t--exclude-op <regex>          Exclude nodes whose operator name matches the regex.\n";
+            std::cerr << "\t--include-type <list>         Only include nodes with an argument or result of the given comma-separated types (e.g. \"bat[:oid]\").\n";
+            std::cerr << "\t--exclude-type <list>         Exclude nodes with an argument or result of the given comma-separated types.\n";
+            std::cerr << "\tIf several include rules are given, a node is included if it matches any of them.\n";
+            std::cerr << "\t--style|-s <file>             Load additional styling rules, one per line, e.g. \"op:algebra.thetaselect fillcolor=red shape=hexagon\".\n";
+            std::cerr << "\t                              Rules match module:, function:, op:, type: or cost: (microseconds, requires --trace) and set\n";
+            std::cerr << "\t                              fillcolor, fontcolor, color (border), shape or penwidth.\n";
+            std::cerr << "\t--trace|-t <file>             Import the output of TRACE for the same plan.\n";
+            std::cerr << "\t--mem-limit <MiB>             Convert plans larger than memory by spilling to sorted runs in the temporary directory.\n";
+            std::cerr << "\t                              Uses about the given amount of memory. Filters and type / cost styling are not supported.\n";
+            std::cerr << "\t--format|-f dot|json|graphml  Output format (default: dot).\n";
+            std::cerr << "\t--output|-o <file>            Write to the given file instead of stdout.\n";
+            std::cerr << "\t--fingerprint                 Only print the fingerprint of the plan, which ignores the numbering of MAL variables.\n";
+            std::cerr << "\t--mask-literals               Ignore the values of literals in the fingerprint.\n";
+            std::cerr << "\t--cache-dir <dir>             Keep the output of every converted plan in the given directory. Plans with the same\n";
+            std::cerr << "\t                              fingerprint and options are copied from there, or linked to with --output.\n";
+            std::cerr << "\t--memory-profile <file>       Estimate the live BATs and bytes per instruction from BAT lifetimes and write them to the file.\n";
+            std::cerr << "\t                              Prints the peak to stderr and highlights the peak instruction (red) and instructions\n";
+            std::cerr << "\t                              keeping long-lived BATs alive (red border). Row counts come from --trace or --rows.\n";
+            std::cerr << "\t--rows <n>                    Row count of BATs without a cardinality in the trace.\n";
+            std::cerr << "\t--serve-http <port>           Do not write the graph, but browse it on http://localhost:<port>/ as collapsed clusters\n";
+            std::cerr << "\t                              whose operators are only loaded when expanded. Runs until interrupted.\n";
+            std::cerr << "\t--cluster-by module|barrier   Cluster operators by module (default) or by innermost barrier block for --serve-http.\n";
             std::cerr << std::flush;
             return 1;
         }
         boost::filesystem::path pathIn(argv[argc - 1]);
-        boost::iostreams::mapped_file file(pathIn);
-
-        ///////////////////////////////////////
-        // Read file and remove unused lines //
-        ///////////////////////////////////////
-        std::vector<std::string> linesVec;
-        char* fileContents = file.data();
-        boost::split(linesVec, fileContents, boost::is_any_of("\r\n"), boost::token_compress_on);
-        std::vector<std::string> splitVec;
-        for (auto iter = linesVec.begin(); iter != linesVec.end();) {
-            std::string& s = *iter;
-            trim(s);
-            ++iter;
-            while (iter != linesVec.end() && iter->size() > 0 && iter->at(0) == ':') {
-                std::string& s2 = *iter++;
-                std::string s3 = s2.substr(2, s2.size() - 4);
-                s.append(trim(s3));
+        PRINT_ERROR_ON(!makeSink(CONFIG.FORMAT, std::cout), "Unknown output format \"" << CONFIG.FORMAT << "\" (one of dot, json, graphml)", __LINE__);
+        std::ofstream fileOut;
+        if (CONFIG.OUTPUT.size() && CONFIG.CACHE_DIR.empty()) {
+            fileOut.open(CONFIG.OUTPUT);
+            PRINT_ERROR_ON(!fileOut, "Could not open output file \"" << CONFIG.OUTPUT << '"', __LINE__);
+        }
+        std::ostream& out = fileOut.is_open() ? fileOut : std::cout;
+        PRINT_ERROR_ON(CONFIG.CLUSTER_BY.size() && CONFIG.CLUSTER_BY != "module" && CONFIG.CLUSTER_BY != "barrier",
+                "Unknown clustering \"" << CONFIG.CLUSTER_BY << "\" (one of module, barrier)", __LINE__);
+        PRINT_ERROR_ON(CONFIG.SERVE_HTTP > 65535, "Invalid port " << CONFIG.SERVE_HTTP << " for --serve-http", __LINE__);
+        if (CONFIG.MEM_LIMIT) {
+            PRINT_ERROR_ON(CONFIG.SERVE_HTTP, "--serve-http is not supported together with --mem-limit", __LINE__);
+            PRINT_ERROR_ON(CONFIG.CACHE_DIR.size() || CONFIG.FINGERPRINT, "Fingerprinting is not supported together with --mem-limit", __LINE__);
+            PRINT_ERROR_ON(CONFIG.MEMORY_PROFILE.size(), "--memory-profile is not supported together with --mem-limit", __LINE__);
+            try {
+                node_filter_t filter(CONFIG);
+                PRINT_ERROR_ON(filter.active(), "Filtering is not supported together with --mem-limit", __LINE__);
+            } catch (std::regex_error & exc) {
+                PRINT_ERROR_ON(true, "Invalid operator regex for --include-op / --exclude-op: " << exc.what(), __LINE__);
             }
-            if (s.size()) {
-                // Certain lines start with special words like "barrier" or "exit" and we don't need these lines for parsing, so only add if the line does NOT start with one of these special words.
-                // bool isNotIgnoredLine = (find_if(IGNORED_LINES_BEGINS.begin(), IGNORED_LINES_BEGINS.end(), [&](string sComp) { return !boost::starts_with(s, sComp); }) == IGNORED_LINES_BEGINS.end());
-                bool isNotIgnoredLine = true;
-                for (auto iter : IGNORED_LINES_BEGINS) {
-                    isNotIgnoredLine &= (s.find(iter) > 0);
-                }
-                // Also ignore lines which contain special operators
-                // bool isNotIgnoredOp = (find_if(IGNORED_OPERATORS.begin(), IGNORED_OPERATORS.end(), [&](string sComp) { return s.find(sComp) == string::npos; }) == IGNORED_OPERATORS.end());
-                bool isNotIgnoredOp = true;
-                for (auto iter : IGNORED_OPERATORS) {
-                    isNotIgnoredOp &= (s.find(iter) == std::string::npos);
-                }
-                if (isNotIgnoredLine && isNotIgnoredOp) {
-                    splitVec.push_back(s);
+            PRINT_ERROR_ON(CONFIG.TRACE_FILE.size(), "--trace is not supported together with --mem-limit", __LINE__);
+            trace_t trace;
+            styler_t styler(trace);
+            try {
+                if (CONFIG.STYLE_FILE.size()) {
+                    styler.load(CONFIG.STYLE_FILE);
                 }
+                PRINT_ERROR_ON(styler.hasNodeRules(), "Style rules on type: or cost: are not supported together with --mem-limit", __LINE__);
+                return convertBounded(CONFIG, pathIn, *makeSink(CONFIG.FORMAT, out), styler, CONFIG.MEM_LIMIT * 1024 * 1024);
+            } catch (std::runtime_error & exc) {
+                std::cerr << exc.what();
+                return __LINE__;
             }
         }
-        const size_t szSplitVec = splitVec.size();
-
-#if defined(VERBOSE)
-        size_t i = 0;
-        for (auto s : splitVec) {
-            cout << "// [VERBOSE] " << (++i) << ": " << s << endl;
-        }
-#endif
 
-        size_t end, pos;
+        ///////////////////////////////////////////////////
+        // Read file instruction by instruction and parse //
+        ///////////////////////////////////////////////////
+        std::ifstream file(pathIn.string());
+        PRINT_ERROR_ON(!file, "Could not open " << pathIn, __LINE__);
+        mal_reader_t reader(file);
+        std::string s;
+        PRINT_ERROR_ON(!reader.read(s), "No instructions found in " << pathIn, __LINE__);
 
         ////////////////////////////////////////////////////
         // Retreive function name, options, and variables //
         ////////////////////////////////////////////////////
-        std::string &s = trim(splitVec[0]);
         if (s.find("auto commit") != std::string::npos) {
-            s = trim(splitVec[1]);
+            PRINT_ERROR_ON(!reader.read(s), "No instructions found after \"auto commit\" in " << pathIn, __LINE__);
         }
-        pos = s.find(FIND_ROOT);
-        PRINT_ERROR_ON(pos == std::string::npos, "Could not find root node \"" << FIND_ROOT << "\" in String\n\t" << s, __LINE__);
-        pos += FIND_ROOT_LEN;
-        end = s.find(FIND_ROOT_OPTIONS, pos);
         std::string rootName;
-        if (end == std::string::npos) {
-            // No options
-            end = s.find(FIND_ROOT_VARS, pos);
-            PRINT_ERROR_ON(end == std::string::npos, "Could not find variables section of root function", __LINE__);
-            rootName = s.substr(pos, end - pos);
-        } else {
-            rootName = s.substr(pos, end - pos);
-            pos = end + 1;
-            end = s.find(FIND_ROOT_OPTIONS_END, pos);
-            PRINT_ERROR_ON(end == std::string::npos, "Could not determine name of root node, while searching for \"" << FIND_ROOT_OPTIONS << "\" in String\n\t" << s, __LINE__);
+        std::vector<std::pair<std::string, std::string>> variables;
+        size_t result = parseRoot(s, rootName, variables);
+        if (result) {
+            return result;
         }
-        trim(rootName);
-        pos = s.find(FIND_ROOT_VARS, end);
-        PRINT_ERROR_ON(pos == std::string::npos, "Could not find variables section of root function", __LINE__);
-        ++pos;
-        end = s.find(FIND_ROOT_VARS_END, pos);
-        PRINT_ERROR_ON(pos == std::string::npos, "Root function variables do not terminate on the same line. This is not yet supported :-(", __LINE__);
-        std::vector<std::string> variables;
-        std::string variablesString = s.substr(pos, end - pos);
-        boost::split(variables, variablesString, boost::is_any_of(","), boost::token_compress_on);
-        for (auto sub : variables) {
-            pos = sub.find(':');
+        for (auto & var : variables) {
             id_t id = nextID();
-            idsToNames[id] = sub.substr(0, pos);
-            namesToIDs[sub.substr(0, pos)] = id;
-            idType[id] = sub.substr(pos + 1);
+            idsToNames[id] = var.first;
+            namesToIDs[var.first] = id;
+            idType[id] = var.second;
         }
 #if defined(DEBUG) or defined(VERBOSE)
         cout << "// [DEBUG] rootName = \"" << rootName << "\"\n";
@@ -334,89 +219,65 @@ namespace e2d {
          #endif
          */
 
-        // start graph output
-        std::cout << "digraph " << pathIn.stem() << " {\n\tnode [shape=box];\n";
-
         id_t mvcID = INVALID_ID;
 
         // Build graph by iterating over all lines.
-        std::vector<std::string> splitVecSub;
-        for (size_t i = 1; i < szSplitVec; ++i) {
-            std::string& s = trim(splitVec[i]);
-            pos = s.find(SQL_ASSIGN);
-            bool isSqlResultSet = boost::starts_with(s, SQL_RESULT_SET);
-            if (!isSqlResultSet && (pos == std::string::npos)) {
+        mal_instruction_t instr;
+        for (size_t i = 1; reader.read(s); ++i) {
+            splitInstruction(s, instr);
+            if (instr.kind == mal_instruction_t::none) {
 #if defined(DEBUG)
                 std::cout << "// [DEBUG] No assignment on line " << (i + 1) << endl;
 #endif
                 continue; // TODO: this is very clumsy handling of the bottom lines!
             }
-            std::string left = isSqlResultSet ? "" : s.substr(0, pos);
-            std::string right = isSqlResultSet ? s : s.substr(pos + SQL_ASSIGN_LEN);
 #if defined(VERBOSE)
-            std::cout << "// [VERBOSE] left: \"" << left << "\" right :\"" << right << "\"\n";
+            std::cout << "// [VERBOSE] left: \"" << instr.left << "\" right :\"" << instr.right << "\"\n";
 #endif
-            // check node name etc.
-            pos = right.find('(');
-            std::string nodeLabel = right.substr(0, pos);
             id_t nodeID = nextID();
-            if (pos == std::string::npos) {
-                trim(nodeLabel, TRIM_ARGS);
+            if (instr.kind != mal_instruction_t::call) {
                 // This is a reassignment (A_x -> A_y) or value assignment (PseudoNode -> A_x)
-                idsToNames[nodeID] = left;
-                namesToIDs[left] = nodeID;
-                if (nodeLabel.find('@') == std::string::npos) {
-                    // Reassignment
-                    PRINT_ERROR_ON(namesToIDs.find(nodeLabel) == namesToIDs.end(), " No ID for argument \"" << nodeLabel << '"', __LINE__);
-                    id_t srcID = namesToIDs[nodeLabel];
+                idsToNames[nodeID] = instr.left;
+                namesToIDs[instr.left] = nodeID;
+                if (instr.kind == mal_instruction_t::reassignment) {
+                    PRINT_ERROR_ON(namesToIDs.find(instr.label) == namesToIDs.end(), " No ID for argument \"" << instr.label << '"', __LINE__);
+                    id_t srcID = namesToIDs[instr.label];
                     reassign[srcID] = nodeID;
                 } else {
                     // Simple value assignment
                     id_t valueID = nextID();
                     values.push_back(valueID);
-                    idsToNames[valueID] = right;
+                    idsToNames[valueID] = instr.right;
                     valueAssign[valueID] = nodeID;
                 }
             } else {
                 nodes.push_back(nodeID);
-                std::string nodeArgs = right.substr(pos, right.size() - pos - 1);
-                trim(nodeArgs, TRIM_ARGS);
-                replaceInString(nodeArgs, '"', '\'');
+                idLabel[nodeID] = instr.label;
+                idArgs[nodeID] = instr.args;
+                idBlock[nodeID] = reader.block();
 
-                bool isMVCNode = nodeLabel.compare(FIND_SQL_MVC) == 0;
-                if (isMVCNode) {
+                if (instr.label.compare(FIND_SQL_MVC) == 0) {
                     mvcID = nodeID;
                 }
 
-                if (!CONFIG.EXCLUDE_MVC || !isMVCNode) {
-                    // PRINT node
-                    std::cout << "\tN" << nodeID << " [label=\"" << nodeLabel << "\\n" << nodeArgs << "\"";
-                    if ((pos = nodeLabel.find('.')) != std::string::npos) {
-                        for (auto p : COLORIZE_BG_PREFIX) {
-                            if (nodeLabel.compare(0, pos, p.first) == 0) {
-                                std::cout << " style=filled fillcolor=" << p.second;
-                                break;
-                            }
-                        }
-                        for (auto p : COLORIZE_FG_PREFIX) {
-                            if (nodeLabel.compare(0, pos, p.first) == 0) {
-                                std::cout << " fontcolor=" << p.second;
-                                break;
-                            }
-                        }
-                    }
-                    std::cout << "];\n";
-                }
-
                 // first parse arguments = right (in) then return values = left (out)
-                PRINT_ERROR_ON(parse(nodeID, nodeArgs, true, i + 1) != 0, " parse node arguments on line " << (i + 1), __LINE__);
-                if (!isSqlResultSet) {
-                    PRINT_ERROR_ON(parse(nodeID, left, false, i + 1) != 0, " parse node return values", __LINE__);
+                PRINT_ERROR_ON(parse(nodeID, instr.args, true, i + 1) != 0, " parse node arguments on line " << (i + 1), __LINE__);
+                if (!instr.isResultSet) {
+                    PRINT_ERROR_ON(parse(nodeID, instr.left, false, i + 1) != 0, " parse node return values", __LINE__);
                 }
             }
         }
 
+        blocks = reader.blocks();
+
+        // fingerprint the plan as parsed, before --exclude-mvc removes edges from it
+        std::string planHash;
+        if (CONFIG.FINGERPRINT || CONFIG.CACHE_DIR.size()) {
+            planHash = planFingerprint(CONFIG.MASK_LITERALS);
+        }
+
         // exclude nodes
+        std::set<id_t> hidden;
         if (CONFIG.EXCLUDE_MVC) {
             // don't throw an error since we want to ignore it anyways
             PRINT_WARN_ON(mvcID == INVALID_ID, "MVC node shall be excluded, but no " << FIND_SQL_MVC << " node found!", __LINE__);
@@ -440,75 +301,87 @@ namespace e2d {
             // nodeOut.erase(mvcID);
             // nodeOut.erase(mvcOutID);
             // idsToNames.erase(mvcID);
+            hidden.insert(mvcID);
         }
-
-        // print values
-        if (values.size()) {
-            std::cout << "\n\tnode [shape=star];\n";
-            for (auto id : values) {
-                std::cout << "\tV" << id << " [label=\"" << idsToNames[id] << "\"];\n";
-            }
-        }
-
-        // Generate unique set of arguments
-        std::map<id_t, id_t> argsMap;
-        for (auto iter : nodeIn) {
-            // for (auto itIn : itNode.second) {
-            argsMap[iter.second] = iter.second;
-            // }
-        }
-        for (auto iter : nodeOut) {
-            // for (auto itOut : itNode.second) {
-            argsMap[iter.second] = iter.second;
-            // }
-        }
-        for (auto itReassign : reassign) {
-            argsMap[itReassign.first] = itReassign.second;
+        std::set<id_t> removed;
+        bool filtered = false;
+        try {
+            node_filter_t filter(CONFIG);
+            filtered = filter.active();
+            removed = filtered ? filter.apply(hidden) : hidden;
+        } catch (std::regex_error & exc) {
+            PRINT_ERROR_ON(true, "Invalid operator regex for --include-op / --exclude-op: " << exc.what(), __LINE__);
         }
 
-        // PRINT argument nodes
-#if defined(DEBUG)
-        std::cout << "\n\t// [DEBUG]";
-        for (auto it : argsMap) {
-            std::cout << " A" << it.first;
+        trace_t trace;
+        styler_t styler(trace);
+        try {
+            if (CONFIG.TRACE_FILE.size()) {
+                trace.load(CONFIG.TRACE_FILE);
+            }
+            if (CONFIG.STYLE_FILE.size()) {
+                styler.load(CONFIG.STYLE_FILE);
+            }
+        } catch (std::runtime_error & exc) {
+            std::cerr << exc.what();
+            return __LINE__;
         }
-#endif
-
-        std::cout << "\n\tnode [shape=ellipse]\n";
-        for (auto it : argsMap) {
-            std::cout << "\tA" << it.first << " [label=\"" << idsToNames[it.first] << "\\n" << idType[it.first] << "\"];\n";
+        styler.compile();
+
+        if (CONFIG.MEMORY_PROFILE.size()) {
+            PRINT_ERROR_ON(trace.empty() && CONFIG.ROWS == 0, "--memory-profile requires row counts from --trace or --rows", __LINE__);
+            memory_profiler_t profiler(trace, CONFIG.ROWS);
+            profiler.analyze();
+            std::ofstream profileOut(CONFIG.MEMORY_PROFILE);
+            PRINT_ERROR_ON(!profileOut, "Could not open memory profile file \"" << CONFIG.MEMORY_PROFILE << '"', __LINE__);
+            profiler.write(profileOut);
+            profiler.summarize(std::cerr);
+            profiler.colorize(styler);
         }
 
-        // PRINT Incoming archs
-        std::cout << "\n";
-        for (auto iter : nodeIn) {
-            // for (auto itIn : iter.second) {
-            std::cout << "\tA" << iter.second << " -> N" << iter.first << ";\n";
-            // }
-        }
-        // PRINT Outgoing archs
-        std::cout << "\n";
-        for (auto iter : nodeOut) {
-            // for (auto itOut : iter.second) {
-            std::cout << "\tN" << iter.first << " -> A" << iter.second << ";\n";
-            // }
-        }
-        // PRINT reassignments
-        if (reassign.size()) {
-            std::cout << "\n";
-            for (auto itReassign : reassign) {
-                std::cout << "\tA" << itReassign.first << " -> A" << itReassign.second << ";\n";
+        if (CONFIG.SERVE_HTTP) {
+            plan_server_t server(pathIn.stem().string(), CONFIG.CLUSTER_BY, removed, styler);
+            try {
+                server.serve(static_cast<unsigned short>(CONFIG.SERVE_HTTP));
+            } catch (std::runtime_error & exc) {
+                PRINT_ERROR_ON(true, "Could not serve on port " << CONFIG.SERVE_HTTP << ": " << exc.what(), __LINE__);
             }
+            return 0;
+        }
+        if (CONFIG.FINGERPRINT) {
+            std::cout << planHash << std::endl;
+            return 0;
         }
-        // PRINT value assignemnts
-        if (values.size()) {
-            std::cout << "\n";
-            for (auto id : values) {
-                std::cout << "\tV" << id << " -> A" << valueAssign[id] << ";\n";
+        if (CONFIG.CACHE_DIR.size()) {
+            // Plans which were already converted with the same options are not emitted again, but linked or copied from the cache.
+            std::string ext = CONFIG.FORMAT.size() ? CONFIG.FORMAT : "dot";
+            boost::filesystem::path cacheDir(CONFIG.CACHE_DIR);
+            boost::filesystem::path cached = cacheDir / (planHash + '-' + optionsFingerprint(CONFIG, argc, argv) + '.' + ext);
+            try {
+                if (!boost::filesystem::exists(cached)) {
+                    boost::filesystem::create_directories(cacheDir);
+                    boost::filesystem::path tmp = cached;
+                    tmp += boost::filesystem::unique_path(".%%%%-%%%%.tmp");
+                    std::ofstream cacheOut(tmp.string());
+                    emitGraph(*makeSink(CONFIG.FORMAT, cacheOut), pathIn.stem().string(), removed, filtered, styler);
+                    cacheOut.close();
+                    PRINT_ERROR_ON(!cacheOut, "Could not write cache file " << tmp, __LINE__);
+                    boost::filesystem::rename(tmp, cached);
+                }
+                if (CONFIG.OUTPUT.size()) {
+                    boost::filesystem::path output(CONFIG.OUTPUT);
+                    boost::filesystem::remove(output);
+                    boost::filesystem::create_symlink(boost::filesystem::absolute(cached), output);
+                } else {
+                    std::ifstream cacheIn(cached.string());
+                    std::cout << cacheIn.rdbuf() << std::flush;
+                }
+            } catch (boost::filesystem::filesystem_error & exc) {
+                PRINT_ERROR_ON(true, exc.what(), __LINE__);
             }
+            return 0;
         }
-
-        std::cout << "}" << std::endl;
+        emitGraph(*makeSink(CONFIG.FORMAT, out), pathIn.stem().string(), removed, filtered, styler);
 
 #if defined(DEBUG) or defined(VERBOSE)
         std::cout << "// [DEBUG] All found variables / BAT's / etc.: {";
@@ -0,0 +1,391 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * extmem.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <algorithm>
+
+#include "common.hpp"
+#include "mal.hpp"
+#include "extmem.hpp"
+
+namespace e2d {
+
+    const size_t MAX_MERGE_FANIN = 64;
+
+    record_t::record_t()
+            : name(),
+              seq(0),
+              kind('\0'),
+              id(INVALID_ID),
+              type() {
+    }
+
+    record_t::record_t(
+            const std::string& name,
+            id_t seq,
+            kind_t kind,
+            id_t id,
+            const std::string& type)
+            : name(name),
+              seq(seq),
+              kind(static_cast<char>(kind)),
+              id(id),
+              type(type) {
+    }
+
+    bool record_t::isDef() const {
+        return kind == defDeclared || kind == defOnUse || kind == defHidden;
+    }
+
+    bool record_t::operator<(
+            const record_t& other) const {
+        int cmp = name.compare(other.name);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        if (seq != other.seq) {
+            return seq < other.seq;
+        }
+        // a use refers to the definition before it, even if it defines the same name itself (X_1 := X_1)
+        return !isDef() && other.isDef();
+    }
+
+    std::ostream& operator<<(
+            std::ostream& os,
+            const record_t& record) {
+        return os << record.name << '\t' << record.seq << '\t' << record.kind << '\t' << record.id << '\t' << record.type << '\n';
+    }
+
+    bool readRecord(
+            std::istream& in,
+            record_t& record) {
+        std::string kind;
+        if (!std::getline(in, record.name, '\t')) {
+            return false;
+        }
+        in >> record.seq;
+        in.ignore();
+        std::getline(in, kind, '\t');
+        in >> record.id;
+        in.ignore();
+        std::getline(in, record.type);
+        record.kind = kind.size() ? kind[0] : '\0';
+        return static_cast<bool>(in);
+    }
+
+    /**
+     * Temporary directory for all spilled data, which is removed again when the conversion is done.
+     */
+    class spill_dir_t {
+    public:
+        const boost::filesystem::path path;
+
+        spill_dir_t()
+                : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("explained2dot-%%%%-%%%%-%%%%")) {
+            boost::filesystem::create_directories(path);
+        }
+
+        ~spill_dir_t() {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(path, ec);
+        }
+    };
+
+    record_sorter_t::record_sorter_t(
+            const boost::filesystem::path& dir,
+            size_t memLimit)
+            : dir(dir),
+              memLimit(memLimit),
+              memUsed(0),
+              buffer(),
+              runs(),
+              nextRun(0) {
+    }
+
+    boost::filesystem::path record_sorter_t::nextRunPath() {
+        std::stringstream ss;
+        ss << "run" << nextRun++;
+        return dir / ss.str();
+    }
+
+    void record_sorter_t::add(
+            record_t&& record) {
+        memUsed += sizeof(record_t) + record.name.capacity() + record.type.capacity();
+        buffer.push_back(std::move(record));
+        if (memUsed >= memLimit) {
+            spill();
+        }
+    }
+
+    void record_sorter_t::spill() {
+        std::sort(buffer.begin(), buffer.end());
+        auto path = nextRunPath();
+        std::ofstream out(path.string());
+        for (auto & record : buffer) {
+            out << record;
+        }
+        if (!out) {
+            THROW_ERROR("Could not write run file " << path, __LINE__)
+        }
+        runs.push_back(path);
+        std::vector<record_t>().swap(buffer);
+        memUsed = 0;
+    }
+
+    size_t record_sorter_t::mergeRuns(
+            const std::vector<boost::filesystem::path>& inputs,
+            const std::function<size_t(const record_t&)>& callback) {
+        typedef std::pair<record_t, size_t> head_t;
+        auto greater = [](const head_t& a, const head_t& b) {
+            return b.first < a.first;
+        };
+        std::vector<std::unique_ptr<std::ifstream>> streams;
+        std::priority_queue<head_t, std::vector<head_t>, decltype(greater)> heads(greater);
+        for (auto & path : inputs) {
+            streams.emplace_back(new std::ifstream(path.string()));
+            record_t record;
+            if (readRecord(*streams.back(), record)) {
+                heads.push(std::make_pair(std::move(record), streams.size() - 1));
+            }
+        }
+        while (!heads.empty()) {
+            head_t head = heads.top();
+            heads.pop();
+            size_t result = callback(head.first);
+            if (result) {
+                return result;
+            }
+            if (readRecord(*streams[head.second], head.first)) {
+                heads.push(std::move(head));
+            }
+        }
+        return 0;
+    }
+
+    size_t record_sorter_t::merge(
+            const std::function<size_t(const record_t&)>& callback) {
+        if (runs.empty()) {
+            std::sort(buffer.begin(), buffer.end());
+            for (auto & record : buffer) {
+                size_t result = callback(record);
+                if (result) {
+                    return result;
+                }
+            }
+            return 0;
+        }
+        if (buffer.size()) {
+            spill();
+        }
+        // reduce the number of runs until all of them can be merged at once
+        while (runs.size() > MAX_MERGE_FANIN) {
+            std::vector<boost::filesystem::path> merged;
+            for (size_t i = 0; i < runs.size(); i += MAX_MERGE_FANIN) {
+                std::vector<boost::filesystem::path> inputs(runs.begin() + i, runs.begin() + std::min(i + MAX_MERGE_FANIN, runs.size()));
+                auto path = nextRunPath();
+                std::ofstream out(path.string());
+                mergeRuns(inputs, [&](const record_t& record) -> size_t {
+                    out << record;
+                    return 0;
+                });
+                for (auto & input : inputs) {
+                    boost::filesystem::remove(input);
+                }
+                merged.push_back(path);
+            }
+            runs.swap(merged);
+        }
+        return mergeRuns(runs, callback);
+    }
+
+    /**
+     * Replays a spooled section line by line, each line holding the tab-separated fields of one sink call.
+     */
+    void replay(
+            const boost::filesystem::path& path,
+            const std::function<void(id_t id, id_t id2, const std::string& rest)>& callback,
+            bool twoIDs) {
+        std::ifstream in(path.string());
+        id_t id, id2 = INVALID_ID;
+        std::string rest;
+        while (in >> id) {
+            if (twoIDs) {
+                in >> id2;
+                in.ignore();
+            } else {
+                in.ignore();
+                std::getline(in, rest);
+            }
+            callback(id, id2, rest);
+        }
+    }
+
+    int convertBounded(
+            const config_t& config,
+            const boost::filesystem::path& pathIn,
+            sink_t& sink,
+            styler_t& styler,
+            size_t memLimit) {
+        std::ifstream in(pathIn.string());
+        PRINT_ERROR_ON(!in, "Could not open " << pathIn, __LINE__);
+        spill_dir_t spillDir;
+        record_sorter_t sorter(spillDir.path, memLimit);
+        // Sections of the output which can only be written after all operator nodes, in the order of the in-memory conversion.
+        std::ofstream valuesOut((spillDir.path / "values").string());
+        std::ofstream argsOut((spillDir.path / "args").string());
+        std::ofstream edgesInOut((spillDir.path / "edgesIn").string());
+        std::ofstream edgesOutOut((spillDir.path / "edgesOut").string());
+        std::ofstream reassignOut((spillDir.path / "reassign").string());
+        std::ofstream valueEdgesOut((spillDir.path / "valueEdges").string());
+
+        mal_reader_t reader(in);
+        std::string s;
+        PRINT_ERROR_ON(!reader.read(s), "No instructions found in " << pathIn, __LINE__);
+        if (s.find("auto commit") != std::string::npos) {
+            PRINT_ERROR_ON(!reader.read(s), "No instructions found after \"auto commit\" in " << pathIn, __LINE__);
+        }
+        std::string rootName;
+        std::vector<std::pair<std::string, std::string>> variables;
+        size_t result = parseRoot(s, rootName, variables);
+        if (result) {
+            return result;
+        }
+        for (auto & var : variables) {
+            id_t id = nextID();
+            sorter.add(record_t(var.first, id, record_t::defOnUse, id, var.second));
+        }
+
+        sink.begin(pathIn.stem().string());
+
+        bool hasValues = false;
+        bool hasReassign = false;
+        mal_instruction_t instr;
+        for (size_t i = 1; reader.read(s); ++i) {
+            splitInstruction(s, instr);
+            if (instr.kind == mal_instruction_t::none) {
+                continue;
+            }
+            id_t nodeID = nextID();
+            if (instr.kind != mal_instruction_t::call) {
+                // the target of a reassignment or value edge is always declared, even if it is never used
+                sorter.add(record_t(instr.left, nodeID, record_t::defDeclared, nodeID, ""));
+                argsOut << nodeID << '\t' << instr.left << '\t' << '\n';
+            }
+            if (instr.kind == mal_instruction_t::reassignment) {
+                sorter.add(record_t(instr.label, nodeID, record_t::useReassign, nodeID, ""));
+            } else if (instr.kind == mal_instruction_t::value) {
+                id_t valueID = nextID();
+                valuesOut << valueID << '\t' << instr.right << '\n';
+                valueEdgesOut << valueID << '\t' << nodeID << '\n';
+                hasValues = true;
+            } else {
+                bool isHidden = config.EXCLUDE_MVC && instr.label.compare(FIND_SQL_MVC) == 0;
+                if (!isHidden) {
+                    sink.node(nodeID, instr.label, instr.args, styler.styleOfLabel(instr.label));
+                }
+                result = parseVars(instr.args, i + 1, [&](const std::string& name, bool, const std::string&) -> size_t {
+                    sorter.add(record_t(name, nodeID, record_t::useNode, nodeID, ""));
+                    return 0;
+                });
+                PRINT_ERROR_ON(result != 0, " parse node arguments on line " << (i + 1), __LINE__);
+                if (!instr.isResultSet) {
+                    result = parseVars(instr.left, i + 1, [&](const std::string& name, bool hasType, const std::string& type) -> size_t {
+                        id_t id = nextID();
+                        if (isHidden) {
+                            sorter.add(record_t(name, id, record_t::defHidden, id, ""));
+                        } else {
+                            sorter.add(record_t(name, id, record_t::defDeclared, id, ""));
+                            argsOut << id << '\t' << name << '\t' << (hasType ? type : "") << '\n';
+                            edgesOutOut << nodeID << '\t' << id << '\n';
+                        }
+                        return 0;
+                    });
+                    PRINT_ERROR_ON(result != 0, " parse node return values", __LINE__);
+                }
+            }
+        }
+
+        // Resolve all uses to the last definition of the same name before them.
+        record_t def;
+        bool declared = false;
+        result = sorter.merge([&](const record_t& record) -> size_t {
+            if (record.isDef()) {
+                def = record;
+                declared = record.kind == record_t::defDeclared;
+                return 0;
+            }
+            PRINT_ERROR_ON(def.id == INVALID_ID || def.name != record.name, "No ID for name \"" << record.name << '"', __LINE__);
+            if (def.kind == record_t::defHidden) {
+                return 0;
+            }
+            if (!declared) {
+                argsOut << def.id << '\t' << def.name << '\t' << def.type << '\n';
+                declared = true;
+            }
+            if (record.kind == record_t::useNode) {
+                edgesInOut << def.id << '\t' << record.id << '\n';
+            } else {
+                reassignOut << def.id << '\t' << record.id << '\n';
+                hasReassign = true;
+            }
+            return 0;
+        });
+        if (result) {
+            return result;
+        }
+
+        for (auto out : {&valuesOut, &argsOut, &edgesInOut, &edgesOutOut, &reassignOut, &valueEdgesOut}) {
+            out->close();
+            PRINT_ERROR_ON(!*out, "Could not write to " << spillDir.path, __LINE__);
+        }
+        auto edges = [&](const char* name, sink_t::edgekind_t kind) {
+            sink.beginEdges(kind);
+            replay(spillDir.path / name, [&](id_t source, id_t target, const std::string&) {
+                sink.edge(kind, source, target);
+            }, true);
+        };
+        if (hasValues) {
+            sink.beginValues();
+            replay(spillDir.path / "values", [&](id_t id, id_t, const std::string& label) {
+                sink.value(id, label);
+            }, false);
+        }
+        sink.beginVariables();
+        replay(spillDir.path / "args", [&](id_t id, id_t, const std::string& rest) {
+            size_t pos = rest.find('\t');
+            sink.variable(id, rest.substr(0, pos), rest.substr(pos + 1));
+        }, false);
+        edges("edgesIn", sink_t::edgeIn);
+        edges("edgesOut", sink_t::edgeOut);
+        if (hasReassign) {
+            edges("reassign", sink_t::edgeReassign);
+        }
+        if (hasValues) {
+            edges("valueEdges", sink_t::edgeValue);
+        }
+        sink.end();
+        return 0;
+    }
+
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * extmem.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include <boost/filesystem.hpp>
+
+#include "config.hpp"
+#include "graph.hpp"
+#include "style.hpp"
+#include "output.hpp"
+
+namespace e2d {
+
+    /**
+     * A variable definition or use, spilled to disk while converting in bounded memory.
+     */
+    struct record_t {
+        enum kind_t {
+            defDeclared = 'D', // definition of a node's result or an assigned variable, which was already declared while parsing
+            defOnUse = 'd', // definition of a root function variable, declared on its first use
+            defHidden = 'h', // definition of the mvc node's result with --exclude-mvc, uses are dropped
+            useNode = 'U', // use as argument of the node with the given ID
+            useReassign = 'R' // use as source of a reassignment to the variable with the given ID
+        };
+
+        std::string name;
+        id_t seq; // position in instruction order (definition: the variable's ID, use: the consumer's ID)
+        char kind;
+        id_t id;
+        std::string type; // type of the variable, only for definitions
+
+        record_t();
+
+        record_t(
+                const std::string& name,
+                id_t seq,
+                kind_t kind,
+                id_t id,
+                const std::string& type);
+
+        bool isDef() const;
+
+        bool operator<(
+                const record_t& other) const;
+    };
+
+    /**
+     * Sorts records by (name, position), using sorted runs on disk if they do not fit into the given amount of memory.
+     */
+    class record_sorter_t {
+
+        boost::filesystem::path dir;
+        size_t memLimit;
+        size_t memUsed;
+        std::vector<record_t> buffer;
+        std::vector<boost::filesystem::path> runs;
+        size_t nextRun;
+
+        void spill();
+
+        boost::filesystem::path nextRunPath();
+
+        size_t mergeRuns(
+                const std::vector<boost::filesystem::path>& inputs,
+                const std::function<size_t(const record_t&)>& callback);
+
+    public:
+        record_sorter_t(
+                const boost::filesystem::path& dir,
+                size_t memLimit);
+
+        void add(
+                record_t&& record);
+
+        /**
+         * Calls the callback for all records in sorted order, stopping at the first non-zero result, which is returned.
+         */
+        size_t merge(
+                const std::function<size_t(const record_t&)>& callback);
+    };
+
+    /**
+     * Converts the plan without keeping it in memory: instructions are streamed, operator nodes are written to the sink right away, and
+     * variable definitions and uses are spilled to sorted runs on disk and resolved with an external merge.
+     *
+     * Filtering is not supported in this mode, and styling only uses module, function and op rules.
+     *
+     * @param memLimit amount of memory in bytes for buffering records before spilling them.
+     * @return 0 on success, otherwise the source line of the error which was already printed.
+     */
+    int convertBounded(
+            const config_t& config,
+            const boost::filesystem::path& pathIn,
+            sink_t& sink,
+            styler_t& styler,
+            size_t memLimit);
+
+}
@@ -0,0 +1,173 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * filter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include "filter.hpp"
+
+namespace e2d {
+
+    const char* const MODULE_BAT = "bat";
+
+    std::set<std::string> splitList(
+            const std::string& s) {
+        std::vector<std::string> items;
+        std::set<std::string> result;
+        if (s.size()) {
+            boost::split(items, s, boost::is_any_of(","), boost::token_compress_on);
+            for (auto & item : items) {
+                boost::trim(item);
+                if (item.size()) {
+                    result.insert(item);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Collects all nodes consuming any result of the given node. Consumers of reassigned variables (X_2 := X_1) count as consumers of
+     * the original variable.
+     */
+    std::set<id_t> consumersOf(
+            id_t nodeID,
+            const std::multimap<id_t, id_t>& varConsumers) {
+        std::set<id_t> consumers;
+        auto range = nodeOut.equal_range(nodeID);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            forEachConsumer(iter->second, varConsumers, [&](id_t consumer) {
+                consumers.insert(consumer);
+            });
+        }
+        return consumers;
+    }
+
+    node_filter_t::node_filter_t(
+            const config_t& config)
+            : includeModules(splitList(config.INCLUDE_MODULE)),
+              excludeModules(splitList(config.EXCLUDE_MODULE)),
+              includeTypes(splitList(config.INCLUDE_TYPE)),
+              excludeTypes(splitList(config.EXCLUDE_TYPE)),
+              hasIncludeOp(config.INCLUDE_OP.size() > 0),
+              hasExcludeOp(config.EXCLUDE_OP.size() > 0),
+              includeOp(hasIncludeOp ? config.INCLUDE_OP : ".*"),
+              excludeOp(hasExcludeOp ? config.EXCLUDE_OP : ".*"),
+              excludeResult(config.EXCLUDE_RESULT),
+              prune(config.PRUNE) {
+    }
+
+    bool node_filter_t::active() const {
+        return includeModules.size() || excludeModules.size() || includeTypes.size() || excludeTypes.size() || hasIncludeOp || hasExcludeOp || excludeResult
+                || prune;
+    }
+
+    bool node_filter_t::matchesType(
+            id_t nodeID,
+            const std::set<std::string>& types) const {
+        if (types.empty()) {
+            return false;
+        }
+        for (auto edges : {&nodeIn, &nodeOut}) {
+            auto range = edges->equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                auto itType = idType.find(iter->second);
+                if (itType != idType.end() && types.count(itType->second)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool node_filter_t::hasIncludes() const {
+        return includeModules.size() || includeTypes.size() || hasIncludeOp;
+    }
+
+    bool node_filter_t::isIncluded(
+            id_t nodeID) const {
+        const std::string& label = idLabel[nodeID];
+        return includeModules.count(moduleOf(label)) || (hasIncludeOp && std::regex_search(label, includeOp)) || matchesType(nodeID, includeTypes);
+    }
+
+    bool node_filter_t::isKept(
+            id_t nodeID) const {
+        const std::string& label = idLabel[nodeID];
+        std::string module = moduleOf(label);
+        if (hasIncludes() && !isIncluded(nodeID)) {
+            return false;
+        }
+        return !(excludeModules.count(module) || (hasExcludeOp && std::regex_search(label, excludeOp)) || matchesType(nodeID, excludeTypes));
+    }
+
+    std::set<id_t> node_filter_t::apply(
+            const std::set<id_t>& hidden) const {
+        std::set<id_t> removed(hidden);
+        std::set<id_t> hiddenNodes(hidden);
+        std::multimap<id_t, id_t> varConsumers = variableConsumers();
+        // Consumers follow their producers in instruction order, so a single backwards pass sees every consumer before its producer.
+        // Inside loops (barrier blocks) this does not hold, but consumers which are not yet decided are simply treated as kept.
+        for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter) {
+            id_t nodeID = *iter;
+            if (hiddenNodes.count(nodeID)) {
+                continue;
+            }
+            if (!isKept(nodeID)) {
+                removed.insert(nodeID);
+                continue;
+            }
+            const std::string& label = idLabel[nodeID];
+            if (excludeResult) {
+                if (label.compare(SQL_RESULT_SET) == 0) {
+                    hiddenNodes.insert(nodeID);
+                    removed.insert(nodeID);
+                    continue;
+                }
+                if (moduleOf(label).compare(MODULE_BAT) == 0) {
+                    auto consumers = consumersOf(nodeID, varConsumers);
+                    bool onlyDescriptor = consumers.size() > 0;
+                    for (auto consumer : consumers) {
+                        onlyDescriptor &= hiddenNodes.count(consumer) > 0;
+                    }
+                    if (onlyDescriptor) {
+                        hiddenNodes.insert(nodeID);
+                        removed.insert(nodeID);
+                        continue;
+                    }
+                }
+            }
+            // nodes matching an include rule were asked for explicitly, so they are roots of the pruning and never pruned themselves
+            if (prune && !hasIncludes()) {
+                auto consumers = consumersOf(nodeID, varConsumers);
+                bool reachesKept = consumers.empty();
+                for (auto consumer : consumers) {
+                    reachesKept |= (removed.count(consumer) == 0) || (hiddenNodes.count(consumer) > 0);
+                }
+                if (!reachesKept) {
+                    removed.insert(nodeID);
+                }
+            }
+        }
+        return removed;
+    }
+
+}
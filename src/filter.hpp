@@ -0,0 +1,88 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * filter.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <string>
+#include <set>
+#include <regex>
+
+#include "config.hpp"
+#include "graph.hpp"
+
+namespace e2d {
+
+    /**
+     * Decides which operator nodes of the parsed graph are emitted.
+     *
+     * Nodes are matched against include / exclude rules on their module, their full operator name (regex) and the types of their
+     * arguments and results. If at least one include rule is given, a node must match one of them to be kept; a node matching any
+     * exclude rule is dropped. Afterwards, producers whose results no longer reach any kept node can be pruned transitively. Nodes
+     * matching an include rule are never pruned.
+     *
+     * Nodes which are only hidden for presentation (the mvc node, the result set and its descriptor BATs) still count as consumers
+     * when pruning, so hiding the result set does not prune the whole plan.
+     */
+    class node_filter_t {
+
+        std::set<std::string> includeModules;
+        std::set<std::string> excludeModules;
+        std::set<std::string> includeTypes;
+        std::set<std::string> excludeTypes;
+        bool hasIncludeOp;
+        bool hasExcludeOp;
+        std::regex includeOp;
+        std::regex excludeOp;
+        bool excludeResult;
+        bool prune;
+
+        bool matchesType(
+                id_t nodeID,
+                const std::set<std::string>& types) const;
+
+        bool hasIncludes() const;
+
+        bool isIncluded(
+                id_t nodeID) const;
+
+        bool isKept(
+                id_t nodeID) const;
+
+    public:
+        /**
+         * @throws std::regex_error if one of the operator patterns is invalid.
+         */
+        node_filter_t(
+                const config_t& config);
+
+        bool active() const;
+
+        /**
+         * Runs the filter as a single backwards pass over the instructions.
+         *
+         * @param hidden nodes which are excluded from the output anyways, but must not trigger pruning.
+         * @return all nodes which must not be emitted, including the hidden ones.
+         */
+        std::set<id_t> apply(
+                const std::set<id_t>& hidden) const;
+    };
+
+}
@@ -0,0 +1,161 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * fingerprint.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <set>
+
+#include "fingerprint.hpp"
+
+namespace e2d {
+
+    const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+    // Operators accessing the catalog. Their literals name the schema, table and column, so they are part of the query, not constants.
+    const std::set<std::string> CATALOG_OPERATORS = {"sql.tid", "sql.bind", "sql.bind_idxbat", "sql.bind_dbat", "sql.emptybind", "sql.emptybindidx"};
+
+    fnv_hasher_t::fnv_hasher_t()
+            : hash(FNV_OFFSET_BASIS) {
+    }
+
+    fnv_hasher_t& fnv_hasher_t::add(
+            const std::string& s) {
+        for (char c : s) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= FNV_PRIME;
+        }
+        // terminate every string, so that ("ab", "c") and ("a", "bc") differ
+        hash ^= 0xFF;
+        hash *= FNV_PRIME;
+        return *this;
+    }
+
+    fnv_hasher_t& fnv_hasher_t::add(
+            uint64_t value) {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+        return *this;
+    }
+
+    std::string fnv_hasher_t::hex() const {
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+
+    std::string maskLiteral(
+            const std::string& literal) {
+        size_t pos = literal.rfind(':');
+        return pos == std::string::npos ? "?" : "?" + literal.substr(pos);
+    }
+
+    std::string planFingerprint(
+            bool maskLiterals) {
+        // all instructions in order: calls, reassignments (keyed by the target variable) and value assignments (keyed by the variable)
+        std::map<id_t, id_t> instructions;
+        for (auto nodeID : nodes) {
+            instructions[nodeID] = INVALID_ID;
+        }
+        for (auto & p : reassign) {
+            instructions[p.second] = p.first;
+        }
+        for (auto & p : valueAssign) {
+            instructions[p.second] = p.first;
+        }
+
+        fnv_hasher_t hasher;
+        std::map<id_t, uint64_t> canonical;
+        auto var = [&](id_t id) {
+            auto result = canonical.insert(std::make_pair(id, canonical.size()));
+            hasher.add(result.first->second);
+            if (result.second) {
+                auto itType = idType.find(id);
+                hasher.add(itType == idType.end() ? std::string() : itType->second);
+            }
+        };
+        for (auto & instr : instructions) {
+            id_t id = instr.first;
+            if (instr.second == INVALID_ID) {
+                hasher.add("call").add(idLabel[id]);
+                bool maskCall = maskLiterals && !CATALOG_OPERATORS.count(idLabel[id]);
+                auto itLiteral = nodeLiterals.lower_bound(id);
+                auto itLiteralEnd = nodeLiterals.upper_bound(id);
+                auto rangeIn = nodeIn.equal_range(id);
+                uint64_t position = 0;
+                for (auto itIn = rangeIn.first; itIn != rangeIn.second || itLiteral != itLiteralEnd; ++position) {
+                    if (itLiteral != itLiteralEnd && itLiteral->second.first == position) {
+                        hasher.add("lit").add(maskCall ? maskLiteral(itLiteral->second.second) : itLiteral->second.second);
+                        ++itLiteral;
+                    } else if (itIn != rangeIn.second) {
+                        hasher.add("var");
+                        var(itIn->second);
+                        ++itIn;
+                    } else {
+                        break;
+                    }
+                }
+                hasher.add("out");
+                auto rangeOut = nodeOut.equal_range(id);
+                for (auto itOut = rangeOut.first; itOut != rangeOut.second; ++itOut) {
+                    var(itOut->second);
+                }
+            } else if (valueAssign.count(instr.second)) {
+                const std::string& value = idsToNames[instr.second];
+                hasher.add("value").add(maskLiterals ? maskLiteral(value) : value);
+                var(id);
+            } else {
+                hasher.add("reassign");
+                var(instr.second);
+                var(id);
+            }
+        }
+        return hasher.hex();
+    }
+
+    std::string optionsFingerprint(
+            const config_t& config,
+            int argc,
+            char** argv) {
+        fnv_hasher_t hasher;
+        for (int nArg = 1; nArg < argc - 1; ++nArg) {
+            std::string arg(argv[nArg]);
+            if (arg == "--output" || arg == "-o" || arg == "--cache-dir") {
+                ++nArg;
+                continue;
+            }
+            hasher.add(arg);
+        }
+        for (auto & path : {config.STYLE_FILE, config.TRACE_FILE}) {
+            if (path.size()) {
+                std::ifstream in(path);
+                std::stringstream ss;
+                ss << in.rdbuf();
+                hasher.add(ss.str());
+            }
+        }
+        return hasher.hex();
+    }
+
+}
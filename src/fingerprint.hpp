@@ -0,0 +1,71 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * fingerprint.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "config.hpp"
+#include "graph.hpp"
+
+namespace e2d {
+
+    /**
+     * 64 bit FNV-1a, which is stable across platforms and runs, unlike std::hash.
+     */
+    class fnv_hasher_t {
+
+        uint64_t hash;
+
+    public:
+        fnv_hasher_t();
+
+        fnv_hasher_t& add(
+                const std::string& s);
+
+        fnv_hasher_t& add(
+                uint64_t value);
+
+        std::string hex() const;
+    };
+
+    /**
+     * Hashes the normalized parsed graph: instructions in order with their operator names, literal arguments and result types, where
+     * all variables are renumbered in the order in which they appear. Plans of the same prepared statement thus get the same
+     * fingerprint, regardless of the MAL variable numbering.
+     *
+     * @param maskLiterals only hash the types of literals (and assigned values), not the values themselves. The schema, table and
+     *                     column names of catalog accesses (sql.bind, sql.tid, ...) are always hashed.
+     */
+    std::string planFingerprint(
+            bool maskLiterals);
+
+    /**
+     * Hashes all command line options which influence the output (everything but the input file, --output and --cache-dir), and the
+     * contents of the style and trace files.
+     */
+    std::string optionsFingerprint(
+            const config_t& config,
+            int argc,
+            char** argv);
+
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * graph.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <set>
+
+#include "graph.hpp"
+
+namespace e2d {
+
+    id_t nextID() {
+        static id_t id = 0;
+        return id++;
+    }
+
+    std::map<id_t, std::string> idsToNames;
+    std::map<std::string, id_t> namesToIDs;
+    std::map<id_t, std::string> idType;
+    std::map<id_t, std::string> idLabel;
+    std::map<id_t, std::string> idArgs;
+    std::map<id_t, size_t> idBlock;
+    std::vector<std::string> blocks;
+    std::multimap<id_t, std::pair<size_t, std::string>> nodeLiterals;
+
+    std::list<id_t> nodes;
+    std::multimap<id_t, id_t> nodeIn;
+    std::multimap<id_t, id_t> nodeOut;
+    std::map<id_t, id_t> reassign;
+    std::list<id_t> values;
+    std::map<id_t, id_t> valueAssign;
+
+    std::string moduleOf(
+            const std::string& label) {
+        size_t pos = label.find('.');
+        return pos == std::string::npos ? std::string() : label.substr(0, pos);
+    }
+
+    std::multimap<id_t, id_t> variableConsumers() {
+        std::multimap<id_t, id_t> varConsumers;
+        for (auto & p : nodeIn) {
+            varConsumers.insert(std::make_pair(p.second, p.first));
+        }
+        return varConsumers;
+    }
+
+    void forEachConsumer(
+            id_t var,
+            const std::multimap<id_t, id_t>& varConsumers,
+            const std::function<void(id_t nodeID)>& consumer) {
+        std::set<id_t> seen;
+        while (seen.insert(var).second) {
+            auto range = varConsumers.equal_range(var);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                consumer(iter->second);
+            }
+            auto itReassign = reassign.find(var);
+            if (itReassign == reassign.end()) {
+                break;
+            }
+            var = itReassign->second;
+        }
+    }
+
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * graph.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <list>
+#include <vector>
+#include <map>
+#include <utility>
+#include <functional>
+
+namespace e2d {
+
+    const id_t INVALID_ID = static_cast<id_t>(-1);
+    const char* const SQL_RESULT_SET = "sql.resultSet";
+
+    id_t nextID();
+
+    /**
+     * The parsed MAL plan. Operator nodes, variables and values all share one ID space, which is assigned in instruction order.
+     */
+    extern std::map<id_t, std::string> idsToNames;
+    extern std::map<std::string, id_t> namesToIDs;
+    extern std::map<id_t, std::string> idType;
+    extern std::map<id_t, std::string> idLabel; // operator name of a node, e.g. "algebra.projection"
+    extern std::map<id_t, std::string> idArgs; // argument string of a node, as printed in its label
+    extern std::map<id_t, size_t> idBlock; // innermost barrier block of a node, see blocks
+    extern std::vector<std::string> blocks; // barrier statement of every block, block 0 is the function itself
+    extern std::multimap<id_t, std::pair<size_t, std::string>> nodeLiterals; // literal arguments of a node with their position, e.g. (1, "5:lng")
+
+    extern std::list<id_t> nodes;
+    extern std::multimap<id_t, id_t> nodeIn;
+    extern std::multimap<id_t, id_t> nodeOut;
+    extern std::map<id_t, id_t> reassign;
+    extern std::list<id_t> values;
+    extern std::map<id_t, id_t> valueAssign;
+
+    /**
+     * @return the module part of an operator name, i.e. everything before the first '.', or the empty string.
+     */
+    std::string moduleOf(
+            const std::string& label);
+
+    /**
+     * @return for every variable the operator nodes reading it, i.e. nodeIn inverted.
+     */
+    std::multimap<id_t, id_t> variableConsumers();
+
+    /**
+     * Calls consumer for every operator node reading the variable, directly or through reassignments of it (X_2 := X_1).
+     *
+     * @param varConsumers the result of variableConsumers().
+     */
+    void forEachConsumer(
+            id_t var,
+            const std::multimap<id_t, id_t>& varConsumers,
+            const std::function<void(id_t nodeID)>& consumer);
+
+}
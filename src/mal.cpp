@@ -0,0 +1,295 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * mal.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "common.hpp"
+#include "graph.hpp"
+#include "mal.hpp"
+
+namespace e2d {
+
+    const char* const FIND_ROOT = "function ";
+    const size_t FIND_ROOT_LEN = strlen(FIND_ROOT);
+    const char* const FIND_ROOT_OPTIONS = "{";
+    const char* const FIND_ROOT_OPTIONS_END = "}";
+    const char* const FIND_ROOT_VARS = "(";
+    const char* const FIND_ROOT_VARS_END = ")";
+    const char* const SQL_ASSIGN = " := ";
+    const size_t SQL_ASSIGN_LEN = strlen(SQL_ASSIGN);
+    const std::list<std::string> IGNORED_NAMES = {"nil", "true", "false"};
+    const std::list<std::string> IGNORED_OPERATORS = {"querylog.define", "language.dataflow", "language.pass"};
+    const std::list<std::string> IGNORED_LINES_BEGINS = {"+", "mal", "barrier ", "exit ", "end "};
+    const char* const FIND_BARRIER = "barrier ";
+    const size_t FIND_BARRIER_LEN = strlen(FIND_BARRIER);
+    const char* const FIND_EXIT = "exit ";
+
+    bool is_number(
+            const std::string& s) {
+        return !s.empty() && find_if(s.begin(), s.end(), [](char c) {
+            return !isdigit(c);}) == s.end();
+    }
+
+    bool parseUnsigned(
+            const std::string& s,
+            size_t& value) {
+        if (!is_number(s)) {
+            return false;
+        }
+        try {
+            size_t idx = 0;
+            value = std::stoul(s, &idx);
+            return idx == s.size();
+        } catch (std::out_of_range &) {
+            return false;
+        }
+    }
+
+    bool ignore(
+            std::string& name) {
+        return ((boost::starts_with(name, "\"") && boost::ends_with(name, "\"")) || (boost::starts_with(name, "'") && boost::ends_with(name, "'"))
+                || (find(IGNORED_NAMES.begin(), IGNORED_NAMES.end(), name) != IGNORED_NAMES.end()) || is_number(name));
+    }
+
+    std::string& replaceInString(
+            std::string& s,
+            char src,
+            char dest) {
+        if (src != dest) {
+            size_t pos = s.find(src);
+            while (pos != std::string::npos) {
+                s.replace(pos, 1, 1, dest);
+                pos = s.find(src, pos);
+            }
+        }
+        return s;
+    }
+
+    mal_reader_t::mal_reader_t(
+            std::istream& in)
+            : in(in),
+              next(),
+              hasNext(false),
+              blockStack(1, 0),
+              blockLabels(1) {
+    }
+
+    bool mal_reader_t::readLine(
+            std::string& line) {
+        while (std::getline(in, line)) {
+            if (line.size() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.size()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool mal_reader_t::read(
+            std::string& instruction) {
+        std::string s;
+        while (hasNext || readLine(s)) {
+            if (hasNext) {
+                s.swap(next);
+                hasNext = false;
+            }
+            trim(s);
+            while (readLine(next)) {
+                if (next[0] != ':') {
+                    hasNext = true;
+                    break;
+                }
+                std::string s3 = next.substr(2, next.size() - 4);
+                s.append(trim(s3));
+            }
+            if (boost::starts_with(s, FIND_BARRIER)) {
+                blockStack.push_back(blockLabels.size());
+                blockLabels.push_back(s.substr(FIND_BARRIER_LEN));
+            } else if (boost::starts_with(s, FIND_EXIT) && blockStack.size() > 1) {
+                blockStack.pop_back();
+            }
+            if (s.size()) {
+                // Certain lines start with special words like "barrier" or "exit" and we don't need these lines for parsing, so only add if the line does NOT start with one of these special words.
+                bool isNotIgnoredLine = true;
+                for (auto iter : IGNORED_LINES_BEGINS) {
+                    isNotIgnoredLine &= (s.find(iter) > 0);
+                }
+                // Also ignore lines which contain special operators
+                bool isNotIgnoredOp = true;
+                for (auto iter : IGNORED_OPERATORS) {
+                    isNotIgnoredOp &= (s.find(iter) == std::string::npos);
+                }
+                if (isNotIgnoredLine && isNotIgnoredOp) {
+                    instruction.swap(s);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    size_t mal_reader_t::block() const {
+        return blockStack.back();
+    }
+
+    const std::vector<std::string>& mal_reader_t::blocks() const {
+        return blockLabels;
+    }
+
+    size_t parseRoot(
+            std::string& s,
+            std::string& rootName,
+            std::vector<std::pair<std::string, std::string>>& variables) {
+        size_t end, pos;
+        pos = s.find(FIND_ROOT);
+        PRINT_ERROR_ON(pos == std::string::npos, "Could not find root node \"" << FIND_ROOT << "\" in String\n\t" << s, __LINE__);
+        pos += FIND_ROOT_LEN;
+        end = s.find(FIND_ROOT_OPTIONS, pos);
+        if (end == std::string::npos) {
+            // No options
+            end = s.find(FIND_ROOT_VARS, pos);
+            PRINT_ERROR_ON(end == std::string::npos, "Could not find variables section of root function", __LINE__);
+            rootName = s.substr(pos, end - pos);
+        } else {
+            rootName = s.substr(pos, end - pos);
+            pos = end + 1;
+            end = s.find(FIND_ROOT_OPTIONS_END, pos);
+            PRINT_ERROR_ON(end == std::string::npos, "Could not determine name of root node, while searching for \"" << FIND_ROOT_OPTIONS << "\" in String\n\t" << s, __LINE__);
+        }
+        trim(rootName);
+        pos = s.find(FIND_ROOT_VARS, end);
+        PRINT_ERROR_ON(pos == std::string::npos, "Could not find variables section of root function", __LINE__);
+        ++pos;
+        end = s.find(FIND_ROOT_VARS_END, pos);
+        PRINT_ERROR_ON(pos == std::string::npos, "Root function variables do not terminate on the same line. This is not yet supported :-(", __LINE__);
+        std::vector<std::string> subs;
+        std::string variablesString = s.substr(pos, end - pos);
+        boost::split(subs, variablesString, boost::is_any_of(","), boost::token_compress_on);
+        for (auto & sub : subs) {
+            pos = sub.find(':');
+            variables.push_back(std::make_pair(sub.substr(0, pos), pos == std::string::npos ? std::string() : sub.substr(pos + 1)));
+        }
+        return 0;
+    }
+
+    mal_instruction_t::mal_instruction_t()
+            : kind(none),
+              isResultSet(false),
+              left(),
+              right(),
+              label(),
+              args() {
+    }
+
+    void splitInstruction(
+            std::string& s,
+            mal_instruction_t& instruction) {
+        trim(s);
+        size_t pos = s.find(SQL_ASSIGN);
+        instruction.isResultSet = boost::starts_with(s, SQL_RESULT_SET);
+        if (!instruction.isResultSet && (pos == std::string::npos)) {
+            instruction.kind = mal_instruction_t::none;
+            return;
+        }
+        instruction.left = instruction.isResultSet ? "" : s.substr(0, pos);
+        instruction.right = instruction.isResultSet ? s : s.substr(pos + SQL_ASSIGN_LEN);
+        // check node name etc.
+        pos = instruction.right.find('(');
+        instruction.label = instruction.right.substr(0, pos);
+        if (pos == std::string::npos) {
+            trim(instruction.label, TRIM_ARGS);
+            // This is a reassignment (A_x -> A_y) or value assignment (PseudoNode -> A_x)
+            instruction.kind = instruction.label.find('@') == std::string::npos ? mal_instruction_t::reassignment : mal_instruction_t::value;
+            instruction.args.clear();
+        } else {
+            instruction.kind = mal_instruction_t::call;
+            instruction.args = instruction.right.substr(pos, instruction.right.size() - pos - 1);
+            trim(instruction.args, TRIM_ARGS);
+            replaceInString(instruction.args, '"', '\'');
+        }
+    }
+
+    size_t parseVars(
+            std::string& s,
+            size_t line,
+            const std::function<size_t(const std::string& name, bool hasType, const std::string& type)>& callback,
+            const std::function<void(const std::string& literal, bool hasType, const std::string& type)>& literalCallback) {
+        size_t beg = 0, pos = 0, pos2 = 0, pos3 = 0;
+        std::string name, type;
+        bool hasType;
+        if (s[0] == '(') {
+            pos2 = std::string::npos;
+            beg = 1;
+            do {
+                if (s[beg] == ')') {
+                    break;
+                } else if (s[beg] == ',') {
+                    ++beg;
+                }
+                hasType = false;
+                pos2 = s.find(',', beg);
+                pos = s.find(':', beg);
+                if (pos == std::string::npos && pos2 == std::string::npos) { // Simple type remaining
+                    name = s.substr(beg, s.size() - beg - 1);
+                } else if (pos < pos2) { // Type information
+                    name = s.substr(beg, pos - beg);
+                    pos3 = s.find('[', pos);
+                    hasType = true;
+                    if (pos3 < pos2) { // bat or other composite type
+                        pos2 = s.find(']', pos3);
+                        PRINT_ERROR_ON(pos2 == std::string::npos, "Did not find finalizing ']' on line " << line, __LINE__);
+                        type = s.substr(pos + 1, pos2 - pos); // the whole bat type
+                    } else { // Simple type with type information
+                        type = s.substr(pos + 1, (pos2 == std::string::npos) ? (s.size() - pos - 2) : (pos2 - pos - 1));
+                    }
+                } else { // Simple type without type information
+                    name = s.substr(beg, pos2 - beg);
+                }
+                trim(name);
+                if (!::e2d::ignore(name)) {
+                    size_t result = callback(name, hasType, type);
+                    if (result) {
+                        return result;
+                    }
+                } else if (literalCallback) {
+                    literalCallback(name, hasType, type);
+                }
+                beg = pos2 == std::string::npos ? std::string::npos : pos2 + 1;
+            } while ((beg != std::string::npos) && ((pos != std::string::npos) || (pos2 != std::string::npos)));
+        } else {
+            pos = s.find(':');
+            name = s.substr(0, pos);
+            trim(name);
+            return callback(name, pos != std::string::npos, pos != std::string::npos ? s.substr(pos + 1) : std::string());
+        }
+        return 0;
+    }
+
+}
@@ -0,0 +1,172 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * mal.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <istream>
+
+namespace e2d {
+
+    const char* const FIND_SQL_MVC = "sql.mvc";
+
+/// FROM HERE taken from the answer from
+/// http://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring
+    const char* const TRIM_CHARS = " \t\n\r\f\v |:";
+
+// trim from end of string (right)
+
+    inline std::string& rtrim(
+            std::string& s,
+            const char* t = TRIM_CHARS) {
+        s.erase(s.find_last_not_of(t) + 1);
+        return s;
+    }
+
+// trim from beginning of string (left)
+
+    inline std::string& ltrim(
+            std::string& s,
+            const char* t = TRIM_CHARS) {
+        s.erase(0, s.find_first_not_of(t));
+        return s;
+    }
+
+// trim from both ends of string (left & right)
+
+    inline std::string& trim(
+            std::string& s,
+            const char* t = TRIM_CHARS) {
+        return ltrim(rtrim(s, t), t);
+    }
+/// UNTIL HERE
+    const char* const TRIM_ARGS = " \t\n\r\f\v |;";
+
+    bool is_number(
+            const std::string& s);
+
+    /**
+     * Parses a non-negative decimal integer without sign, spaces or trailing characters.
+     *
+     * @return false if s is no such integer or does not fit into a size_t.
+     */
+    bool parseUnsigned(
+            const std::string& s,
+            size_t& value);
+
+    bool ignore(
+            std::string& name);
+
+    std::string& replaceInString(
+            std::string& s,
+            char src,
+            char dest);
+
+    /**
+     * Reads the instructions of an EXPLAIN output one at a time, so that the file never has to be held in memory. Continuation lines
+     * (starting with ':') are appended to their instruction, and lines which are irrelevant for the graph (table borders, barrier
+     * blocks, querylog.define, dataflow, ...) are skipped. The barrier blocks are still tracked, see block().
+     */
+    class mal_reader_t {
+
+        std::istream& in;
+        std::string next;
+        bool hasNext;
+        std::vector<size_t> blockStack;
+        std::vector<std::string> blockLabels;
+
+        bool readLine(
+                std::string& line);
+
+    public:
+        mal_reader_t(
+                std::istream& in);
+
+        /**
+         * @return false if there are no more instructions.
+         */
+        bool read(
+                std::string& instruction);
+
+        /**
+         * @return the innermost barrier block of the last instruction read, or 0 outside of any block.
+         */
+        size_t block() const;
+
+        /**
+         * @return the barrier statements (e.g. "X_104:bit := language.dataflow();") of all blocks read so far, indexed by block. Block 0
+         * is the function itself and has an empty label.
+         */
+        const std::vector<std::string>& blocks() const;
+    };
+
+    /**
+     * Extracts name and variables (name and type) of the root function, e.g. "function user.s4_1(A0:int,A1:str):void;".
+     *
+     * @return 0 on success, otherwise the source line of the error which was already printed.
+     */
+    size_t parseRoot(
+            std::string& s,
+            std::string& rootName,
+            std::vector<std::pair<std::string, std::string>>& variables);
+
+    /**
+     * A single MAL instruction "left := right", split into its parts.
+     */
+    struct mal_instruction_t {
+        enum kind_t {
+            none, // no assignment at all
+            call, // left := label(args)
+            reassignment, // left := X_1
+            value // left := 0@0:oid
+        };
+
+        kind_t kind;
+        bool isResultSet;
+        std::string left;
+        std::string right;
+        std::string label;
+        std::string args;
+
+        mal_instruction_t();
+    };
+
+    void splitInstruction(
+            std::string& s,
+            mal_instruction_t& instruction);
+
+    /**
+     * Calls the callback with name and type (if any) for all variables in a list like "(X_1:bat[:oid],X_2,3:int)" or for the single
+     * variable "X_1:bat[:oid]". Literals in lists are passed to literalCallback instead, if given.
+     *
+     * @return 0 on success, otherwise the source line of the error which was already printed, or the callback's non-zero result.
+     */
+    size_t parseVars(
+            std::string& s,
+            size_t line,
+            const std::function<size_t(const std::string& name, bool hasType, const std::string& type)>& callback,
+            const std::function<void(const std::string& literal, bool hasType, const std::string& type)>& literalCallback = nullptr);
+
+}
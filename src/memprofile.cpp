@@ -0,0 +1,178 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * memprofile.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <map>
+#include <algorithm>
+#include <iomanip>
+#include <cstring>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "memprofile.hpp"
+
+namespace e2d {
+
+    const char* const BAT_TYPE_PREFIX = "bat[:";
+    const size_t LONG_LIVED_DIVISOR = 4; // BATs living longer than 1/4 of the plan are long-lived
+    const size_t SUMMARY_TOP_BATS = 5;
+    const std::map<std::string, size_t> TYPE_WIDTHS = { {"void", 0}, {"bit", 1}, {"bte", 1}, {"sht", 2}, {"int", 4}, {"flt", 4}, {"date", 4}, {"lng", 8}, {"dbl", 8}, {"oid", 8}, {
+            "daytime", 8}, {"timestamp", 8}, {"hge", 16}, {"str", 8}}; // str: only the offset heap, string heaps are not estimated
+    const size_t DEFAULT_TYPE_WIDTH = 8;
+
+    size_t widthOf(
+            const std::string& type) {
+        size_t pos = type.find(']');
+        auto iter = TYPE_WIDTHS.find(type.substr(strlen(BAT_TYPE_PREFIX), pos == std::string::npos ? std::string::npos : pos - strlen(BAT_TYPE_PREFIX)));
+        return iter == TYPE_WIDTHS.end() ? DEFAULT_TYPE_WIDTH : iter->second;
+    }
+
+    memory_profiler_t::memory_profiler_t(
+            const trace_t& trace,
+            size_t defaultRows)
+            : trace(trace),
+              defaultRows(defaultRows),
+              order(),
+              liveBATs(),
+              liveBytes(),
+              intervals(),
+              bats(),
+              batBytes(),
+              extenders(),
+              peak(0) {
+    }
+
+    void memory_profiler_t::analyze() {
+        order.assign(nodes.begin(), nodes.end());
+        std::map<id_t, size_t> position;
+        for (size_t i = 0; i < order.size(); ++i) {
+            position[order[i]] = i;
+        }
+        std::multimap<id_t, id_t> varConsumers = variableConsumers();
+
+        // liveness interval of every intermediate BAT
+        for (auto & p : nodeOut) {
+            auto itType = idType.find(p.second);
+            if (itType == idType.end() || !boost::starts_with(itType->second, BAT_TYPE_PREFIX)) {
+                continue;
+            }
+            size_t first = position[p.first];
+            size_t last = first;
+            forEachConsumer(p.second, varConsumers, [&](id_t consumer) {
+                last = std::max(last, position[consumer]);
+            });
+            bats.push_back(p.second);
+            intervals.push_back(std::make_pair(first, last));
+            batBytes.push_back(trace.rowsOf(p.second, defaultRows) * widthOf(itType->second));
+            if ((last - first) * LONG_LIVED_DIVISOR > order.size()) {
+                extenders.insert(order[last]);
+            }
+        }
+
+        // sweep over the instructions; a BAT is still live at its last use
+        std::vector<long long> delta(order.size() + 1);
+        std::vector<long long> deltaCount(order.size() + 1);
+        for (size_t i = 0; i < bats.size(); ++i) {
+            delta[intervals[i].first] += batBytes[i];
+            delta[intervals[i].second + 1] -= batBytes[i];
+            ++deltaCount[intervals[i].first];
+            --deltaCount[intervals[i].second + 1];
+        }
+        liveBytes.assign(order.size(), 0);
+        liveBATs.assign(order.size(), 0);
+        long long bytes = 0, count = 0;
+        peak = 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            bytes += delta[i];
+            count += deltaCount[i];
+            liveBytes[i] = static_cast<size_t>(bytes);
+            liveBATs[i] = static_cast<size_t>(count);
+            if (liveBytes[i] > liveBytes[peak]) {
+                peak = i;
+            }
+        }
+    }
+
+    void memory_profiler_t::colorize(
+            styler_t& styler) const {
+        style_t extender;
+        extender.color = "red";
+        extender.penwidth = "3";
+        for (auto nodeID : extenders) {
+            styler.override(nodeID, extender);
+        }
+        if (order.size()) {
+            style_t peakStyle;
+            peakStyle.fillcolor = "red";
+            peakStyle.fontcolor = "white";
+            styler.override(order[peak], peakStyle);
+        }
+    }
+
+    void memory_profiler_t::write(
+            std::ostream& out) const {
+        std::vector<std::vector<size_t>> startsAt(order.size()), endsAt(order.size());
+        for (size_t i = 0; i < bats.size(); ++i) {
+            startsAt[intervals[i].first].push_back(i);
+            endsAt[intervals[i].second].push_back(i);
+        }
+        std::set<size_t> live;
+        out << "position\tnode\toperator\tlive_bats\tbytes\tlive\n";
+        for (size_t i = 0; i < order.size(); ++i) {
+            live.insert(startsAt[i].begin(), startsAt[i].end());
+            out << i << "\tN" << order[i] << '\t' << idLabel[order[i]] << '\t' << liveBATs[i] << '\t' << liveBytes[i] << '\t';
+            const char* sep = "";
+            for (auto bat : live) {
+                out << sep << idsToNames[bats[bat]];
+                sep = ",";
+            }
+            out << '\n';
+            for (auto bat : endsAt[i]) {
+                live.erase(bat);
+            }
+        }
+    }
+
+    void memory_profiler_t::summarize(
+            std::ostream& out) const {
+        if (order.empty()) {
+            out << "Memory profile: no instructions\n";
+            return;
+        }
+        out << "Memory profile: peak of " << liveBytes[peak] << " bytes (" << std::fixed << std::setprecision(1) << (liveBytes[peak] / 1048576.0) << " MiB) in "
+                << liveBATs[peak] << " live BATs at instruction " << peak << " (N" << order[peak] << ' ' << idLabel[order[peak]] << ")\n";
+        std::vector<size_t> live;
+        for (size_t i = 0; i < bats.size(); ++i) {
+            if (intervals[i].first <= peak && peak <= intervals[i].second) {
+                live.push_back(i);
+            }
+        }
+        std::sort(live.begin(), live.end(), [&](size_t a, size_t b) {
+            return batBytes[a] > batBytes[b];
+        });
+        for (size_t i = 0; i < live.size() && i < SUMMARY_TOP_BATS; ++i) {
+            size_t bat = live[i];
+            out << "\t" << idsToNames[bats[bat]] << ':' << idType[bats[bat]] << "\t" << batBytes[bat] << " bytes, live from instruction " << intervals[bat].first << " to "
+                    << intervals[bat].second << "\n";
+        }
+        out << "\t" << extenders.size() << " instructions keep long-lived BATs alive\n";
+    }
+
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * memprofile.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <set>
+#include <ostream>
+
+#include "graph.hpp"
+#include "trace.hpp"
+#include "style.hpp"
+
+namespace e2d {
+
+    /**
+     * Estimates the memory footprint of a plan before running it, from the liveness of its intermediate BATs.
+     *
+     * A BAT is live from the instruction producing it up to its last use (following reassignments). Its size is the number of rows
+     * (from an imported TRACE log, or a default) times the width of its tail type.
+     */
+    class memory_profiler_t {
+
+        const trace_t& trace;
+        size_t defaultRows;
+
+        std::vector<id_t> order; // operator nodes in instruction order
+        std::vector<size_t> liveBATs; // per instruction
+        std::vector<size_t> liveBytes; // per instruction
+        std::vector<std::pair<size_t, size_t>> intervals; // [first, last] instruction of every BAT, parallel to bats
+        std::vector<id_t> bats;
+        std::vector<size_t> batBytes;
+        std::set<id_t> extenders;
+        size_t peak;
+
+    public:
+        memory_profiler_t(
+                const trace_t& trace,
+                size_t defaultRows);
+
+        /**
+         * Computes the liveness intervals and the live BATs and bytes per instruction on the parsed plan.
+         */
+        void analyze();
+
+        /**
+         * Marks the peak instruction and the instructions which keep long-lived BATs alive, i.e. the last uses of BATs living for more
+         * than a quarter of the plan.
+         */
+        void colorize(
+                styler_t& styler) const;
+
+        /**
+         * Writes one tab-separated line per instruction: position, node, operator, live BATs, estimated bytes and the BATs live there.
+         */
+        void write(
+                std::ostream& out) const;
+
+        /**
+         * Writes a short summary of the peak instruction.
+         */
+        void summarize(
+                std::ostream& out) const;
+    };
+
+}
@@ -0,0 +1,487 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * output.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <map>
+#include <iomanip>
+
+#include "output.hpp"
+
+namespace e2d {
+
+    const char* const EDGE_KIND_NAMES[] = {"in", "out", "reassign", "value"};
+
+    char sourcePrefix(
+            sink_t::edgekind_t kind) {
+        return kind == sink_t::edgeOut ? 'N' : (kind == sink_t::edgeValue ? 'V' : 'A');
+    }
+
+    char targetPrefix(
+            sink_t::edgekind_t kind) {
+        return kind == sink_t::edgeIn ? 'N' : 'A';
+    }
+
+    sink_t::~sink_t() {
+    }
+
+    /**
+     * Graphviz, as printed by explained2dot from the beginning.
+     */
+    class dot_sink_t : public sink_t {
+
+        std::ostream& out;
+
+    public:
+        dot_sink_t(
+                std::ostream& out)
+                : out(out) {
+        }
+
+        void begin(
+                const std::string& name) override {
+            out << "digraph \"" << name << "\" {\n\tnode [shape=box];\n";
+        }
+
+        void node(
+                id_t id,
+                const std::string& label,
+                const std::string& args,
+                const style_t& style) override {
+            out << "\tN" << id << " [label=\"" << label << "\\n" << args << "\"" << style << "];\n";
+        }
+
+        void beginValues() override {
+            out << "\n\tnode [shape=star];\n";
+        }
+
+        void value(
+                id_t id,
+                const std::string& label) override {
+            out << "\tV" << id << " [label=\"" << label << "\"];\n";
+        }
+
+        void beginVariables() override {
+            out << "\n\tnode [shape=ellipse]\n";
+        }
+
+        void variable(
+                id_t id,
+                const std::string& name,
+                const std::string& type) override {
+            out << "\tA" << id << " [label=\"" << name << "\\n" << type << "\"];\n";
+        }
+
+        void beginEdges(
+                edgekind_t) override {
+            out << "\n";
+        }
+
+        void edge(
+                edgekind_t kind,
+                id_t source,
+                id_t target) override {
+            out << '\t' << sourcePrefix(kind) << source << " -> " << targetPrefix(kind) << target << ";\n";
+        }
+
+        void end() override {
+            out << "}" << std::endl;
+        }
+    };
+
+    std::ostream& operator<<(
+            std::ostream& os,
+            const escaped_t& e) {
+        for (char c : e.s) {
+            if (e.xml) {
+                switch (c) {
+                    case '&':
+                        os << "&amp;";
+                        break;
+                    case '<':
+                        os << "&lt;";
+                        break;
+                    case '>':
+                        os << "&gt;";
+                        break;
+                    case '"':
+                        os << "&quot;";
+                        break;
+                    default:
+                        os << c;
+                }
+            } else {
+                switch (c) {
+                    case '"':
+                        os << "\\\"";
+                        break;
+                    case '\\':
+                        os << "\\\\";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                        } else {
+                            os << c;
+                        }
+                }
+            }
+        }
+        return os;
+    }
+
+    /**
+     * {"name": ..., "nodes": [...], "edges": [...]} with one node or edge per line.
+     */
+    class json_sink_t : public sink_t {
+
+        std::ostream& out;
+        bool first;
+        bool inEdges;
+
+        std::ostream& element() {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            return out;
+        }
+
+        escaped_t esc(
+                const std::string& s) {
+            return escaped_t {s, false};
+        }
+
+    public:
+        json_sink_t(
+                std::ostream& out)
+                : out(out),
+                  first(true),
+                  inEdges(false) {
+        }
+
+        void begin(
+                const std::string& name) override {
+            out << "{\"name\":\"" << esc(name) << "\",\"nodes\":[";
+        }
+
+        void node(
+                id_t id,
+                const std::string& label,
+                const std::string& args,
+                const style_t& style) override {
+            element() << "{\"id\":\"N" << id << "\",\"kind\":\"operator\",\"label\":\"" << esc(label) << "\",\"module\":\"" << esc(moduleOf(label)) << "\",\"args\":\""
+                    << esc(args) << '"';
+            if (!style.empty()) {
+                const char* sep = "";
+                out << ",\"style\":{";
+                for (auto attr : { std::make_pair("fillcolor", &style.fillcolor), std::make_pair("fontcolor", &style.fontcolor), std::make_pair("color", &style.color), std::make_pair("shape", &style.shape), std::make_pair(
+                        "penwidth", &style.penwidth)}) {
+                    if (attr.second->size()) {
+                        out << sep << '"' << attr.first << "\":\"" << esc(*attr.second) << '"';
+                        sep = ",";
+                    }
+                }
+                out << '}';
+            }
+            out << '}';
+        }
+
+        void beginValues() override {
+        }
+
+        void value(
+                id_t id,
+                const std::string& label) override {
+            element() << "{\"id\":\"V" << id << "\",\"kind\":\"value\",\"label\":\"" << esc(label) << "\"}";
+        }
+
+        void beginVariables() override {
+        }
+
+        void variable(
+                id_t id,
+                const std::string& name,
+                const std::string& type) override {
+            element() << "{\"id\":\"A" << id << "\",\"kind\":\"variable\",\"name\":\"" << esc(name) << "\",\"type\":\"" << esc(type) << "\"}";
+        }
+
+        void beginEdges(
+                edgekind_t) override {
+            if (!inEdges) {
+                out << "\n],\"edges\":[";
+                first = true;
+                inEdges = true;
+            }
+        }
+
+        void edge(
+                edgekind_t kind,
+                id_t source,
+                id_t target) override {
+            element() << "{\"source\":\"" << sourcePrefix(kind) << source << "\",\"target\":\"" << targetPrefix(kind) << target << "\",\"kind\":\"" << EDGE_KIND_NAMES[kind]
+                    << "\"}";
+        }
+
+        void end() override {
+            beginEdges(edgeIn);
+            out << "\n]}" << std::endl;
+        }
+    };
+
+    class graphml_sink_t : public sink_t {
+
+        std::ostream& out;
+
+        escaped_t esc(
+                const std::string& s) {
+            return escaped_t {s, true};
+        }
+
+        void data(
+                const char* key,
+                const std::string& value) {
+            if (value.size()) {
+                out << "<data key=\"" << key << "\">" << esc(value) << "</data>";
+            }
+        }
+
+    public:
+        graphml_sink_t(
+                std::ostream& out)
+                : out(out) {
+        }
+
+        void begin(
+                const std::string& name) override {
+            out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+            out << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n";
+            for (auto key : {"kind", "label", "module", "args", "name", "type", "fillcolor", "fontcolor", "color", "shape", "penwidth"}) {
+                out << "  <key id=\"" << key << "\" for=\"node\" attr.name=\"" << key << "\" attr.type=\"string\"/>\n";
+            }
+            out << "  <key id=\"edgekind\" for=\"edge\" attr.name=\"kind\" attr.type=\"string\"/>\n";
+            out << "  <graph id=\"" << esc(name) << "\" edgedefault=\"directed\">\n";
+        }
+
+        void node(
+                id_t id,
+                const std::string& label,
+                const std::string& args,
+                const style_t& style) override {
+            out << "    <node id=\"N" << id << "\">";
+            data("kind", "operator");
+            data("label", label);
+            data("module", moduleOf(label));
+            data("args", args);
+            data("fillcolor", style.fillcolor);
+            data("fontcolor", style.fontcolor);
+            data("color", style.color);
+            data("shape", style.shape);
+            data("penwidth", style.penwidth);
+            out << "</node>\n";
+        }
+
+        void beginValues() override {
+        }
+
+        void value(
+                id_t id,
+                const std::string& label) override {
+            out << "    <node id=\"V" << id << "\">";
+            data("kind", "value");
+            data("label", label);
+            out << "</node>\n";
+        }
+
+        void beginVariables() override {
+        }
+
+        void variable(
+                id_t id,
+                const std::string& name,
+                const std::string& type) override {
+            out << "    <node id=\"A" << id << "\">";
+            data("kind", "variable");
+            data("name", name);
+            data("type", type);
+            out << "</node>\n";
+        }
+
+        void beginEdges(
+                edgekind_t) override {
+        }
+
+        void edge(
+                edgekind_t kind,
+                id_t source,
+                id_t target) override {
+            out << "    <edge source=\"" << sourcePrefix(kind) << source << "\" target=\"" << targetPrefix(kind) << target << "\">";
+            data("edgekind", EDGE_KIND_NAMES[kind]);
+            out << "</edge>\n";
+        }
+
+        void end() override {
+            out << "  </graph>\n</graphml>" << std::endl;
+        }
+    };
+
+    std::unique_ptr<sink_t> makeSink(
+            const std::string& format,
+            std::ostream& out) {
+        if (format.empty() || format == "dot") {
+            return std::unique_ptr<sink_t>(new dot_sink_t(out));
+        } else if (format == "json") {
+            return std::unique_ptr<sink_t>(new json_sink_t(out));
+        } else if (format == "graphml") {
+            return std::unique_ptr<sink_t>(new graphml_sink_t(out));
+        }
+        return std::unique_ptr<sink_t>();
+    }
+
+    void emitGraph(
+            sink_t& sink,
+            const std::string& name,
+            const std::set<id_t>& removed,
+            bool filtered,
+            const styler_t& styler) {
+        sink.begin(name);
+
+        // nodes
+        for (auto nodeID : nodes) {
+            if (!removed.count(nodeID)) {
+                sink.node(nodeID, idLabel[nodeID], idArgs[nodeID], styler.styleOf(nodeID));
+            }
+        }
+
+        // Generate unique set of arguments
+        std::map<id_t, id_t> argsMap;
+        for (auto iter : nodeIn) {
+            if (!removed.count(iter.first)) {
+                argsMap[iter.second] = iter.second;
+            }
+        }
+        for (auto iter : nodeOut) {
+            if (!removed.count(iter.first)) {
+                argsMap[iter.second] = iter.second;
+            }
+        }
+        std::map<id_t, id_t> reassignShown;
+        for (auto itReassign : reassign) {
+            if (!filtered || argsMap.count(itReassign.first) || argsMap.count(itReassign.second)) {
+                argsMap[itReassign.first] = itReassign.first;
+                argsMap[itReassign.second] = itReassign.second;
+                reassignShown.insert(itReassign);
+            }
+        }
+        // a value is only shown if the variable it assigns is shown, too
+        std::vector<id_t> valuesShown;
+        for (auto id : values) {
+            if (!filtered || argsMap.count(valueAssign[id])) {
+                valuesShown.push_back(id);
+            }
+        }
+        // every edge endpoint is declared, so that JSON and GraphML reference existing nodes only
+        for (auto id : valuesShown) {
+            argsMap[valueAssign[id]] = valueAssign[id];
+        }
+
+        // values
+        if (valuesShown.size()) {
+            sink.beginValues();
+            for (auto id : valuesShown) {
+                sink.value(id, idsToNames[id]);
+            }
+        }
+
+        // argument nodes
+        sink.beginVariables();
+        for (auto it : argsMap) {
+            sink.variable(it.first, idsToNames[it.first], idType[it.first]);
+        }
+
+        // Incoming archs
+        sink.beginEdges(sink_t::edgeIn);
+        for (auto iter : nodeIn) {
+            if (!removed.count(iter.first)) {
+                sink.edge(sink_t::edgeIn, iter.second, iter.first);
+            }
+        }
+        // Outgoing archs
+        sink.beginEdges(sink_t::edgeOut);
+        for (auto iter : nodeOut) {
+            if (!removed.count(iter.first)) {
+                sink.edge(sink_t::edgeOut, iter.first, iter.second);
+            }
+        }
+        // reassignments
+        if (reassignShown.size()) {
+            sink.beginEdges(sink_t::edgeReassign);
+            for (auto itReassign : reassignShown) {
+                sink.edge(sink_t::edgeReassign, itReassign.first, itReassign.second);
+            }
+        }
+        // value assignemnts
+        if (valuesShown.size()) {
+            sink.beginEdges(sink_t::edgeValue);
+            for (auto id : valuesShown) {
+                sink.edge(sink_t::edgeValue, id, valueAssign[id]);
+            }
+        }
+
+        sink.end();
+    }
+
+    void emitSubgraph(
+            sink_t& sink,
+            const std::string& name,
+            const std::vector<id_t>& nodeIDs,
+            const styler_t& styler) {
+        sink.begin(name);
+        std::set<id_t> args;
+        for (auto nodeID : nodeIDs) {
+            sink.node(nodeID, idLabel[nodeID], idArgs[nodeID], styler.styleOf(nodeID));
+            auto range = nodeIn.equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                args.insert(iter->second);
+            }
+            range = nodeOut.equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                args.insert(iter->second);
+            }
+        }
+        sink.beginVariables();
+        for (auto id : args) {
+            sink.variable(id, idsToNames[id], idType[id]);
+        }
+        sink.beginEdges(sink_t::edgeIn);
+        for (auto nodeID : nodeIDs) {
+            auto range = nodeIn.equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                sink.edge(sink_t::edgeIn, iter->second, nodeID);
+            }
+        }
+        sink.beginEdges(sink_t::edgeOut);
+        for (auto nodeID : nodeIDs) {
+            auto range = nodeOut.equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                sink.edge(sink_t::edgeOut, nodeID, iter->second);
+            }
+        }
+        sink.end();
+    }
+
+}
@@ -0,0 +1,128 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * output.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <string>
+#include <set>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+#include "graph.hpp"
+#include "style.hpp"
+
+namespace e2d {
+
+    /**
+     * Receives the graph element by element and writes it in some output format, without buffering it.
+     *
+     * The calls always come in this order: begin, node*, [beginValues, value*], beginVariables, variable*, (beginEdges, edge*)*, end.
+     * Node IDs of the different kinds are written as "N<id>" (operators), "V<id>" (values) and "A<id>" (variables).
+     */
+    class sink_t {
+    public:
+        enum edgekind_t {
+            edgeIn, // variable -> operator
+            edgeOut, // operator -> variable
+            edgeReassign, // variable -> variable
+            edgeValue // value -> variable
+        };
+
+        virtual ~sink_t();
+
+        virtual void begin(
+                const std::string& name) = 0;
+
+        virtual void node(
+                id_t id,
+                const std::string& label,
+                const std::string& args,
+                const style_t& style) = 0;
+
+        virtual void beginValues() = 0;
+
+        virtual void value(
+                id_t id,
+                const std::string& label) = 0;
+
+        virtual void beginVariables() = 0;
+
+        virtual void variable(
+                id_t id,
+                const std::string& name,
+                const std::string& type) = 0;
+
+        virtual void beginEdges(
+                edgekind_t kind) = 0;
+
+        virtual void edge(
+                edgekind_t kind,
+                id_t source,
+                id_t target) = 0;
+
+        virtual void end() = 0;
+    };
+
+    /**
+     * Escapes a string for JSON or XML while writing it.
+     */
+    struct escaped_t {
+        const std::string& s;
+        bool xml;
+    };
+
+    std::ostream& operator<<(
+            std::ostream& os,
+            const escaped_t& e);
+
+    /**
+     * @param format one of "dot", "json" or "graphml".
+     * @return the sink writing to out, or nullptr for an unknown format.
+     */
+    std::unique_ptr<sink_t> makeSink(
+            const std::string& format,
+            std::ostream& out);
+
+    /**
+     * Writes the parsed graph without the removed nodes and their edges.
+     *
+     * @param filtered whether a node filter chose the removed nodes. Otherwise they are only hidden for presentation (the mvc node),
+     *                 and reassignments and values are shown as without any removed node.
+     */
+    void emitGraph(
+            sink_t& sink,
+            const std::string& name,
+            const std::set<id_t>& removed,
+            bool filtered,
+            const styler_t& styler);
+
+    /**
+     * Writes only the given operator nodes, the variables they read or write, and their incoming and outgoing edges. Values and
+     * reassignments are left out. Only looks at the edges of the given nodes, so its cost does not depend on the size of the plan.
+     */
+    void emitSubgraph(
+            sink_t& sink,
+            const std::string& name,
+            const std::vector<id_t>& nodeIDs,
+            const styler_t& styler);
+
+}
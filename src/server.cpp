@@ -0,0 +1,403 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * server.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <iostream>
+#include <sstream>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include <boost/asio.hpp>
+
+#include "server.hpp"
+#include "output.hpp"
+
+namespace e2d {
+
+    const size_t MAX_REQUEST_SIZE = 64 * 1024;
+    const long CONNECTION_TIMEOUT_MS = 5000;
+    const long ACCEPT_BACKOFF_MS = 1000;
+
+    /**
+     * One accepted connection, kept alive by the handlers of its pending operations.
+     */
+    struct http_connection_t {
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::steady_timer deadline;
+        boost::asio::streambuf request;
+        std::string response;
+
+        http_connection_t(
+                boost::asio::io_context& io)
+                : socket(io),
+                  deadline(io),
+                  request(MAX_REQUEST_SIZE),
+                  response() {
+        }
+
+        void close() {
+            boost::system::error_code ignored;
+            deadline.cancel();
+            socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+            socket.close(ignored);
+        }
+    };
+
+    const char* const VIEWER_PAGE = R"html(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>explained2dot</title>
+<style>
+body { font-family: sans-serif; font-size: 14px; }
+summary { cursor: pointer; padding: 2px; }
+details { margin: 4px 0; border-left: 3px solid #ccc; padding-left: 6px; }
+table { border-collapse: collapse; margin: 4px 0 8px 16px; }
+td { border: 1px solid #ddd; padding: 2px 6px; font-family: monospace; }
+.edges { color: #666; }
+</style>
+</head>
+<body>
+<h3 id="name"></h3>
+<div id="clusters">Loading...</div>
+<script>
+function text(tag, s, cls) {
+    var e = document.createElement(tag);
+    e.textContent = s;
+    if (cls) {
+        e.className = cls;
+    }
+    return e;
+}
+function expand(d, id, labels) {
+    fetch('cluster?id=' + encodeURIComponent(id)).then(function (r) { return r.json(); }).then(function (c) {
+        var vars = {}, from = {}, ins = {}, outs = {};
+        c.graph.nodes.forEach(function (n) { if (n.kind == 'variable') vars[n.id] = n.name + ':' + n.type; });
+        c.inputs.forEach(function (i) { from[i.variable] = labels[i.cluster]; });
+        c.graph.edges.forEach(function (e) {
+            if (e.kind == 'in') {
+                (ins[e.target] = ins[e.target] || []).push(vars[e.source] + (from[e.source] ? ' [' + from[e.source] + ']' : ''));
+            } else {
+                (outs[e.source] = outs[e.source] || []).push(vars[e.target]);
+            }
+        });
+        var t = document.createElement('table');
+        c.graph.nodes.forEach(function (n) {
+            if (n.kind != 'operator') {
+                return;
+            }
+            var r = t.insertRow();
+            r.insertCell().textContent = (outs[n.id] || []).join(', ');
+            var op = r.insertCell();
+            op.textContent = n.label;
+            op.title = n.args;
+            if (n.style) {
+                op.style.background = n.style.fillcolor || '';
+                op.style.color = n.style.fontcolor || '';
+                op.style.border = n.style.color ? '2px solid ' + n.style.color : '';
+            }
+            r.insertCell().textContent = (ins[n.id] || []).join(', ');
+        });
+        d.appendChild(t);
+    });
+}
+fetch('clusters').then(function (r) { return r.json(); }).then(function (top) {
+    var labels = {}, edges = {}, root = document.getElementById('clusters');
+    document.title = top.name;
+    document.getElementById('name').textContent = top.name;
+    root.textContent = '';
+    top.clusters.forEach(function (c) { labels[c.id] = c.label; });
+    top.edges.forEach(function (e) { (edges[e.source] = edges[e.source] || []).push(labels[e.target] + ' (' + e.count + ')'); });
+    top.clusters.forEach(function (c) {
+        var d = document.createElement('details'), s = document.createElement('summary');
+        s.appendChild(text('b', c.label));
+        s.appendChild(text('span', ' ' + c.nodes + ' operators'));
+        if (edges[c.id]) {
+            s.appendChild(text('span', ' → ' + edges[c.id].join(', '), 'edges'));
+        }
+        d.appendChild(s);
+        d.addEventListener('toggle', function () {
+            if (d.open && !d.dataset.loaded) {
+                d.dataset.loaded = '1';
+                expand(d, c.id, labels);
+            }
+        });
+        root.appendChild(d);
+    });
+});
+</script>
+</body>
+</html>
+)html";
+
+    std::string urlDecode(
+            const std::string& s) {
+        std::string result;
+        for (size_t i = 0; i < s.size(); ++i) {
+            if (s[i] == '+') {
+                result.push_back(' ');
+            } else if (s[i] == '%' && i + 2 < s.size() && std::isxdigit(s[i + 1]) && std::isxdigit(s[i + 2])) {
+                result.push_back(static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16)));
+                i += 2;
+            } else {
+                result.push_back(s[i]);
+            }
+        }
+        return result;
+    }
+
+    std::string queryParameter(
+            const std::string& query,
+            const std::string& key) {
+        std::istringstream params(query);
+        std::string param;
+        while (std::getline(params, param, '&')) {
+            size_t posEq = param.find('=');
+            if (posEq != std::string::npos && urlDecode(param.substr(0, posEq)) == key) {
+                return urlDecode(param.substr(posEq + 1));
+            }
+        }
+        return std::string();
+    }
+
+    plan_server_t::plan_server_t(
+            const std::string& name,
+            const std::string& clusterBy,
+            const std::set<id_t>& removed,
+            const styler_t& styler)
+            : name(name),
+              clusterBy(clusterBy.size() ? clusterBy : "module"),
+              styler(styler),
+              clusterIDs(),
+              clusterLabels(),
+              clusterNodes(),
+              clusterIndex(),
+              clusterOf(),
+              producers(),
+              topLevel() {
+        bool byBarrier = this->clusterBy == "barrier";
+        for (auto nodeID : nodes) {
+            if (removed.count(nodeID)) {
+                continue;
+            }
+            std::string id;
+            std::string label;
+            if (byBarrier) {
+                size_t block = idBlock[nodeID];
+                id = 'B' + std::to_string(block);
+                label = block ? blocks[block] : name;
+            } else {
+                id = label = moduleOf(idLabel[nodeID]);
+            }
+            auto iter = clusterIndex.find(id);
+            if (iter == clusterIndex.end()) {
+                iter = clusterIndex.insert(std::make_pair(id, clusterIDs.size())).first;
+                clusterIDs.push_back(id);
+                clusterLabels.push_back(label);
+                clusterNodes.emplace_back();
+            }
+            clusterNodes[iter->second].push_back(nodeID);
+            clusterOf[nodeID] = iter->second;
+        }
+    }
+
+    void plan_server_t::buildProducers() {
+        if (producers.size()) {
+            return;
+        }
+        for (auto iter : nodeOut) {
+            producers[iter.second] = iter.first;
+        }
+        // reassignments are ordered by their source, so the producer of a reassigned source is always known before
+        for (auto iter : reassign) {
+            auto itProducer = producers.find(iter.first);
+            if (itProducer != producers.end()) {
+                producers[iter.second] = itProducer->second;
+            }
+        }
+    }
+
+    std::string plan_server_t::clustersJSON() {
+        if (topLevel.size()) {
+            return topLevel;
+        }
+        buildProducers();
+        std::map<std::pair<size_t, size_t>, size_t> edges;
+        for (size_t cluster = 0; cluster < clusterNodes.size(); ++cluster) {
+            for (auto nodeID : clusterNodes[cluster]) {
+                auto range = nodeIn.equal_range(nodeID);
+                for (auto iter = range.first; iter != range.second; ++iter) {
+                    auto itProducer = producers.find(iter->second);
+                    if (itProducer == producers.end()) {
+                        continue;
+                    }
+                    auto itCluster = clusterOf.find(itProducer->second);
+                    if (itCluster != clusterOf.end() && itCluster->second != cluster) {
+                        ++edges[std::make_pair(itCluster->second, cluster)];
+                    }
+                }
+            }
+        }
+        std::ostringstream out;
+        out << "{\"name\":\"" << escaped_t {name, false} << "\",\"clusters\":[";
+        for (size_t cluster = 0; cluster < clusterIDs.size(); ++cluster) {
+            out << (cluster ? ",\n" : "\n") << "{\"id\":\"" << escaped_t {clusterIDs[cluster], false} << "\",\"label\":\"" << escaped_t {clusterLabels[cluster], false}
+                    << "\",\"nodes\":" << clusterNodes[cluster].size() << '}';
+        }
+        out << "\n],\"edges\":[";
+        const char* sep = "\n";
+        for (auto edge : edges) {
+            out << sep << "{\"source\":\"" << escaped_t {clusterIDs[edge.first.first], false} << "\",\"target\":\"" << escaped_t {clusterIDs[edge.first.second], false}
+                    << "\",\"count\":" << edge.second << '}';
+            sep = ",\n";
+        }
+        out << "\n]}\n";
+        topLevel = out.str();
+        return topLevel;
+    }
+
+    std::string plan_server_t::clusterJSON(
+            size_t cluster) {
+        buildProducers();
+        std::ostringstream out;
+        out << "{\"id\":\"" << escaped_t {clusterIDs[cluster], false} << "\",\"graph\":";
+        emitSubgraph(*makeSink("json", out), clusterLabels[cluster], clusterNodes[cluster], styler);
+        out << ",\"inputs\":[";
+        const char* sep = "\n";
+        std::set<id_t> seen;
+        for (auto nodeID : clusterNodes[cluster]) {
+            auto range = nodeIn.equal_range(nodeID);
+            for (auto iter = range.first; iter != range.second; ++iter) {
+                auto itProducer = producers.find(iter->second);
+                if (itProducer == producers.end() || !seen.insert(iter->second).second) {
+                    continue;
+                }
+                auto itCluster = clusterOf.find(itProducer->second);
+                if (itCluster != clusterOf.end() && itCluster->second != cluster) {
+                    out << sep << "{\"variable\":\"A" << iter->second << "\",\"cluster\":\"" << escaped_t {clusterIDs[itCluster->second], false} << "\"}";
+                    sep = ",\n";
+                }
+            }
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    bool plan_server_t::handle(
+            const std::string& target,
+            std::string& contentType,
+            std::string& body) {
+        size_t posQuery = target.find('?');
+        std::string path = target.substr(0, posQuery);
+        std::string query = posQuery == std::string::npos ? std::string() : target.substr(posQuery + 1);
+        if (path == "/" || path == "/index.html") {
+            contentType = "text/html; charset=utf-8";
+            body = VIEWER_PAGE;
+            return true;
+        }
+        contentType = "application/json";
+        if (path == "/clusters") {
+            body = clustersJSON();
+            return true;
+        } else if (path == "/cluster") {
+            auto iter = clusterIndex.find(queryParameter(query, "id"));
+            if (iter != clusterIndex.end()) {
+                body = clusterJSON(iter->second);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string plan_server_t::respond(
+            const std::string& method,
+            const std::string& target) {
+        std::string contentType("text/plain");
+        std::string body;
+        const char* status = "200 OK";
+        if (method != "GET") {
+            status = "405 Method Not Allowed";
+            body = "Only GET is supported\n";
+        } else if (!handle(target, contentType, body)) {
+            contentType = "text/plain";
+            status = "404 Not Found";
+            body = "Not found: " + target + '\n';
+        }
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << "\r\nContent-Type: " << contentType << "\r\nContent-Length: " << body.size() << "\r\nConnection: close\r\n\r\n" << body;
+        return response.str();
+    }
+
+    void plan_server_t::serve(
+            unsigned short port) {
+        using boost::asio::ip::tcp;
+        boost::asio::io_context io;
+        tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+        std::cerr << "Serving \"" << name << "\" (" << clusterIDs.size() << " clusters by " << clusterBy << ") on http://localhost:" << port << '/' << std::endl;
+        // Everything runs on this thread, but no connection can block the others: a connection which does not send its request and
+        // take the response within the deadline is closed.
+        boost::asio::steady_timer backoff(io);
+        std::function<void()> accept = [&]() {
+            auto conn = std::make_shared<http_connection_t>(io);
+            acceptor.async_accept(conn->socket, [&, conn](const boost::system::error_code& ec) {
+                if (ec == boost::asio::error::operation_aborted) {
+                    return;
+                } else if (ec) {
+                    // e.g. out of file descriptors: retrying immediately would only spin, so wait for connections to be closed
+                    std::cerr << "[WARN @ server.cpp:" << __LINE__ << "] Could not accept a connection: " << ec.message() << std::endl;
+                    backoff.expires_after(std::chrono::milliseconds(ACCEPT_BACKOFF_MS));
+                    backoff.async_wait([&](const boost::system::error_code& ecTimer) {
+                        if (!ecTimer) {
+                            accept();
+                        }
+                    });
+                    return;
+                } else {
+                    conn->deadline.expires_after(std::chrono::milliseconds(CONNECTION_TIMEOUT_MS));
+                    conn->deadline.async_wait([conn](const boost::system::error_code& ecTimer) {
+                        if (!ecTimer) {
+                            conn->close();
+                        }
+                    });
+                    boost::asio::async_read_until(conn->socket, conn->request, "\r\n\r\n", [this, conn](const boost::system::error_code& ecRead, size_t) {
+                        if (ecRead) {
+                            conn->close();
+                            return;
+                        }
+                        std::istream in(&conn->request);
+                        std::string method;
+                        std::string target;
+                        in >> method >> target;
+                        conn->response = respond(method, target);
+                        boost::asio::async_write(conn->socket, boost::asio::buffer(conn->response), [conn](const boost::system::error_code&, size_t) {
+                            conn->close();
+                        });
+                    });
+                }
+                accept();
+            });
+        };
+        accept();
+        io.run();
+    }
+
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * server.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "graph.hpp"
+#include "style.hpp"
+
+namespace e2d {
+
+    /**
+     * Serves the parsed plan on a local HTTP port for browsing it level by level, instead of laying out all of it at once.
+     *
+     * The top level only shows clusters of operators (by module or by barrier block) and the number of variables passed between them.
+     * The nodes and edges of a cluster are only computed and sent when it is expanded in the browser:
+     *   GET /                  the viewer page
+     *   GET /clusters          {"name", "clusters": [{"id", "label", "nodes"}], "edges": [{"source", "target", "count"}]}
+     *   GET /cluster?id=<id>   {"id", "graph": <JSON output of the cluster's operators>, "inputs": [{"variable", "cluster"}]}
+     */
+    class plan_server_t {
+
+        std::string name;
+        std::string clusterBy;
+        const styler_t& styler;
+
+        // clusters in order of first appearance in the plan
+        std::vector<std::string> clusterIDs;
+        std::vector<std::string> clusterLabels;
+        std::vector<std::vector<id_t>> clusterNodes;
+        std::map<std::string, size_t> clusterIndex;
+        std::map<id_t, size_t> clusterOf; // operator node -> cluster
+        std::map<id_t, id_t> producers; // variable -> operator node writing it, built with the first request which needs it
+        std::string topLevel; // body of /clusters, built with the first request
+
+        void buildProducers();
+
+        std::string clustersJSON();
+
+        std::string clusterJSON(
+                size_t cluster);
+
+        std::string respond(
+                const std::string& method,
+                const std::string& target);
+
+    public:
+        /**
+         * @param clusterBy "module" (default) or "barrier".
+         */
+        plan_server_t(
+                const std::string& name,
+                const std::string& clusterBy,
+                const std::set<id_t>& removed,
+                const styler_t& styler);
+
+        /**
+         * Answers a GET request for the given target (path and query).
+         * @return false if there is nothing at the target.
+         */
+        bool handle(
+                const std::string& target,
+                std::string& contentType,
+                std::string& body);
+
+        /**
+         * Accepts connections on the loopback interface until the process is stopped. Connections which do not complete their request
+         * and response within a few seconds are closed, so idle connections (e.g. preconnects of browsers) do not block the others.
+         * Throws std::runtime_error if the port can not be opened.
+         */
+        void serve(
+                unsigned short port);
+    };
+
+}
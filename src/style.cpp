@@ -0,0 +1,309 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * style.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+#include "common.hpp"
+#include "mal.hpp"
+#include "style.hpp"
+
+namespace e2d {
+
+    const std::vector<std::string> DEFAULT_STYLE_RULES = {"module:algebra fillcolor=cyan", "module:aggr fillcolor=green", "module:batcalc fillcolor=gold",
+            "module:group fillcolor=orangered fontcolor=white", "module:sql fillcolor=gainsboro", "module:bat fillcolor=peachpuff"};
+
+    style_t::style_t()
+            : fillcolor(),
+              fontcolor(),
+              color(),
+              shape(),
+              penwidth() {
+    }
+
+    bool style_t::empty() const {
+        return fillcolor.empty() && fontcolor.empty() && color.empty() && shape.empty() && penwidth.empty();
+    }
+
+    style_t& style_t::merge(
+            const style_t& other) {
+        if (other.fillcolor.size()) {
+            fillcolor = other.fillcolor;
+        }
+        if (other.fontcolor.size()) {
+            fontcolor = other.fontcolor;
+        }
+        if (other.color.size()) {
+            color = other.color;
+        }
+        if (other.shape.size()) {
+            shape = other.shape;
+        }
+        if (other.penwidth.size()) {
+            penwidth = other.penwidth;
+        }
+        return *this;
+    }
+
+    /**
+     * Writes name="value" for DOT. Values come from the user's rule file, so they are always quoted (e.g. "#ff0000").
+     */
+    void writeAttribute(
+            std::ostream& os,
+            const char* name,
+            const std::string& value) {
+        os << ' ' << name << "=\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                os << '\\';
+            }
+            os << c;
+        }
+        os << '"';
+    }
+
+    std::ostream& operator<<(
+            std::ostream& os,
+            const style_t& style) {
+        if (style.fillcolor.size()) {
+            os << " style=filled";
+            writeAttribute(os, "fillcolor", style.fillcolor);
+        }
+        if (style.fontcolor.size()) {
+            writeAttribute(os, "fontcolor", style.fontcolor);
+        }
+        if (style.color.size()) {
+            writeAttribute(os, "color", style.color);
+        }
+        if (style.shape.size()) {
+            writeAttribute(os, "shape", style.shape);
+        }
+        if (style.penwidth.size()) {
+            writeAttribute(os, "penwidth", style.penwidth);
+        }
+        return os;
+    }
+
+    styler_t::styler_t(
+            const trace_t& trace)
+            : rules(),
+              labelStyles(),
+              typeStyles(),
+              costStyles(),
+              nodeStyles(),
+              trace(trace) {
+        size_t lineNo = 0;
+        for (auto & line : DEFAULT_STYLE_RULES) {
+            addRule(line, ++lineNo);
+        }
+    }
+
+    void styler_t::addRule(
+            const std::string& line,
+            size_t lineNo) {
+        std::vector<std::string> tokens;
+        std::string trimmed = boost::trim_copy(line);
+        if (trimmed.empty() || trimmed[0] == '#') {
+            return;
+        }
+        // split at blanks outside of double quotes, so that values like fillcolor="0.650 0.200 1.000" stay one token
+        bool quoted = false;
+        tokens.emplace_back();
+        for (char c : trimmed) {
+            if (c == '"') {
+                quoted = !quoted;
+            } else if (!quoted && (c == ' ' || c == '\t')) {
+                if (tokens.back().size()) {
+                    tokens.emplace_back();
+                }
+                continue;
+            }
+            tokens.back().push_back(c);
+        }
+        if (quoted) {
+            THROW_ERROR("Unterminated quote in style rule on line " << lineNo << ": \"" << line << '"', __LINE__)
+        }
+        rule_t rule {matchmodule, "", 0, style_t()};
+        size_t pos = tokens[0].find(':');
+        if (pos == std::string::npos || pos + 1 == tokens[0].size()) {
+            THROW_ERROR("Style rule on line " << lineNo << " does not start with \"<kind>:<pattern>\": \"" << line << '"', __LINE__)
+        }
+        std::string kind = tokens[0].substr(0, pos);
+        rule.pattern = tokens[0].substr(pos + 1);
+        if (kind == "module") {
+            rule.matchType = matchmodule;
+        } else if (kind == "function") {
+            rule.matchType = matchfunction;
+        } else if (kind == "op") {
+            rule.matchType = matchop;
+        } else if (kind == "type") {
+            rule.matchType = matchtype;
+        } else if (kind == "cost") {
+            rule.matchType = matchcost;
+            if (!parseUnsigned(rule.pattern, rule.cost)) {
+                THROW_ERROR("Cost of style rule on line " << lineNo << " is not a non-negative integer in range (is \"" << rule.pattern << "\")!", __LINE__)
+            }
+        } else {
+            THROW_ERROR("Unknown kind \"" << kind << "\" of style rule on line " << lineNo << " (one of module, function, op, type, cost)", __LINE__)
+        }
+        if (tokens.size() < 2) {
+            THROW_ERROR("Style rule on line " << lineNo << " does not set any attribute", __LINE__)
+        }
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            pos = tokens[i].find('=');
+            std::string key = tokens[i].substr(0, pos);
+            std::string value = pos == std::string::npos ? "" : tokens[i].substr(pos + 1);
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                value = value.substr(1, value.size() - 2);
+            }
+            if (value.empty()) {
+                THROW_ERROR("Attribute \"" << key << "\" of style rule on line " << lineNo << " has no value", __LINE__)
+            }
+            if (key == "fillcolor") {
+                rule.style.fillcolor = value;
+            } else if (key == "fontcolor") {
+                rule.style.fontcolor = value;
+            } else if (key == "color") {
+                rule.style.color = value;
+            } else if (key == "shape") {
+                rule.style.shape = value;
+            } else if (key == "penwidth") {
+                rule.style.penwidth = value;
+            } else {
+                THROW_ERROR("Unknown attribute \"" << key << "\" of style rule on line " << lineNo << " (one of fillcolor, fontcolor, color, shape, penwidth)",
+                        __LINE__)
+            }
+        }
+        rules.push_back(rule);
+    }
+
+    void styler_t::load(
+            const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            THROW_ERROR("Could not open style file \"" << path << '"', __LINE__)
+        }
+        std::string line;
+        size_t lineNo = 0;
+        while (std::getline(in, line)) {
+            addRule(line, ++lineNo);
+        }
+    }
+
+    bool styler_t::hasNodeRules() const {
+        for (auto & rule : rules) {
+            if (rule.matchType == matchtype || rule.matchType == matchcost) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    style_t styler_t::compileLabel(
+            const std::string& label) const {
+        size_t pos = label.find('.');
+        std::string module = moduleOf(label);
+        std::string function = pos == std::string::npos ? label : label.substr(pos + 1);
+        style_t style;
+        for (auto & rule : rules) {
+            if ((rule.matchType == matchmodule && rule.pattern == module) || (rule.matchType == matchfunction && rule.pattern == function)
+                    || (rule.matchType == matchop && rule.pattern == label)) {
+                style.merge(rule.style);
+            }
+        }
+        return style;
+    }
+
+    void styler_t::compile() {
+        labelStyles.clear();
+        typeStyles.clear();
+        costStyles.clear();
+        for (auto & p : idLabel) {
+            if (!labelStyles.count(p.second)) {
+                labelStyles[p.second] = compileLabel(p.second);
+            }
+        }
+        for (auto & rule : rules) {
+            if (rule.matchType == matchtype) {
+                typeStyles[rule.pattern].merge(rule.style);
+            } else if (rule.matchType == matchcost) {
+                costStyles[rule.cost].merge(rule.style);
+            }
+        }
+        // make the cost styles cumulative, so that a single lookup suffices per node
+        style_t cumulative;
+        for (auto & p : costStyles) {
+            p.second = cumulative.merge(p.second);
+        }
+    }
+
+    style_t styler_t::styleOf(
+            id_t nodeID) const {
+        style_t style;
+        auto itLabel = labelStyles.find(idLabel[nodeID]);
+        if (itLabel != labelStyles.end()) {
+            style = itLabel->second;
+        }
+        if (typeStyles.size()) {
+            for (auto edges : {&nodeIn, &nodeOut}) {
+                auto range = edges->equal_range(nodeID);
+                for (auto iter = range.first; iter != range.second; ++iter) {
+                    auto itType = idType.find(iter->second);
+                    if (itType != idType.end()) {
+                        auto itStyle = typeStyles.find(itType->second);
+                        if (itStyle != typeStyles.end()) {
+                            style.merge(itStyle->second);
+                        }
+                    }
+                }
+            }
+        }
+        if (costStyles.size() && !trace.empty()) {
+            auto itCost = costStyles.upper_bound(trace.costOf(nodeID));
+            if (itCost != costStyles.begin()) {
+                style.merge((--itCost)->second);
+            }
+        }
+        auto itNode = nodeStyles.find(nodeID);
+        if (itNode != nodeStyles.end()) {
+            style.merge(itNode->second);
+        }
+        return style;
+    }
+
+    const style_t& styler_t::styleOfLabel(
+            const std::string& label) {
+        auto iter = labelStyles.find(label);
+        if (iter == labelStyles.end()) {
+            iter = labelStyles.insert(std::make_pair(label, compileLabel(label))).first;
+        }
+        return iter->second;
+    }
+
+    void styler_t::override(
+            id_t nodeID,
+            const style_t& style) {
+        nodeStyles[nodeID].merge(style);
+    }
+
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * style.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <ostream>
+
+#include "graph.hpp"
+#include "trace.hpp"
+
+namespace e2d {
+
+    /**
+     * Graphviz attributes of an operator node. Empty attributes are not set.
+     */
+    struct style_t {
+        std::string fillcolor;
+        std::string fontcolor;
+        std::string color;
+        std::string shape;
+        std::string penwidth;
+
+        style_t();
+
+        bool empty() const;
+
+        /**
+         * Overrides all attributes which are set in other.
+         */
+        style_t& merge(
+                const style_t& other);
+    };
+
+    std::ostream& operator<<(
+            std::ostream& os,
+            const style_t& style);
+
+    /**
+     * Styling rules, either built in or loaded from a file with one rule per line:
+     *
+     *   # comment
+     *   module:algebra              fillcolor=cyan
+     *   function:thetaselect        shape=hexagon
+     *   op:group.groupdone          fillcolor=orangered fontcolor=white
+     *   type:bat[:oid]              penwidth=2
+     *   cost:1000                   penwidth=4
+     *   op:algebra.join             fillcolor="0.650 0.200 1.000"
+     *
+     * Values containing blanks must be enclosed in double quotes.
+     * "cost:N" matches nodes which took at least N microseconds in an imported TRACE log. Later rules override earlier ones, cost rules
+     * with a higher threshold override those with a lower one, and type / cost rules override module / function / op rules. Rules from
+     * a file are applied after the built-in ones. Styles set by analyses (see override()) are applied last.
+     *
+     * Since module, function and op rules only depend on the operator name, they are compiled once per distinct operator of the plan
+     * into a hash table, so styling a node does not depend on the number of rules.
+     */
+    class styler_t {
+
+        enum matchtype_t {
+            matchmodule,
+            matchfunction,
+            matchop,
+            matchtype,
+            matchcost
+        };
+
+        struct rule_t {
+            matchtype_t matchType;
+            std::string pattern;
+            size_t cost;
+            style_t style;
+        };
+
+        std::vector<rule_t> rules;
+        std::unordered_map<std::string, style_t> labelStyles;
+        std::unordered_map<std::string, style_t> typeStyles;
+        std::map<size_t, style_t> costStyles; // cumulative style for all nodes with at least the given cost
+        std::map<id_t, style_t> nodeStyles;
+        const trace_t& trace;
+
+        void addRule(
+                const std::string& line,
+                size_t lineNo);
+
+        style_t compileLabel(
+                const std::string& label) const;
+
+    public:
+        styler_t(
+                const trace_t& trace);
+
+        /**
+         * @throws std::runtime_error if the file cannot be read or contains an invalid rule.
+         */
+        void load(
+                const std::string& path);
+
+        /**
+         * @return true if some rule matches more than the operator name (type: or cost:), which needs the parsed plan.
+         */
+        bool hasNodeRules() const;
+
+        /**
+         * Compiles the rules for all operators of the parsed plan. Must be called after parsing and before styleOf().
+         */
+        void compile();
+
+        style_t styleOf(
+                id_t nodeID) const;
+
+        /**
+         * Sets attributes of a single node, overriding all rules.
+         */
+        void override(
+                id_t nodeID,
+                const style_t& style);
+
+        /**
+         * Styles an operator by its name only, compiling the rules for it on first use. This does not need the parsed plan.
+         */
+        const style_t& styleOfLabel(
+                const std::string& label);
+    };
+
+}
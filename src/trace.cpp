@@ -0,0 +1,108 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * trace.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#include <fstream>
+#include <regex>
+#include <algorithm>
+#include <cctype>
+
+#include "common.hpp"
+#include "mal.hpp"
+#include "trace.hpp"
+
+namespace e2d {
+
+    const char* const TRACE_ASSIGN = " := ";
+    // result variable with its optional value, e.g. "X_5=[1000]:bat[:oid]" or "X_6=<tmp_27>[1000]:bat[:oid]"
+    const std::regex TRACE_RESULT_VAR("([A-Za-z_][A-Za-z0-9_]*)(=[^,:()]*)?");
+    // variable with its cardinality, e.g. "X_5=[1000]" or "X_6=<tmp_27>[1000]"
+    const std::regex TRACE_VAR_ROWS("([A-Za-z_][A-Za-z0-9_]*)=(<[^>]*>)?\\[([0-9]+)\\]");
+
+    trace_t::trace_t()
+            : usec(),
+              rows() {
+    }
+
+    void trace_t::load(
+            const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            THROW_ERROR("Could not open trace file \"" << path << '"', __LINE__)
+        }
+        std::string line;
+        size_t lineNo = 0;
+        while (std::getline(in, line)) {
+            ++lineNo;
+            // "| <usec> | <statement> |"
+            size_t pos = line.find_first_not_of(" \t|");
+            if (pos == std::string::npos || !std::isdigit(line[pos])) {
+                continue;
+            }
+            size_t end = line.find('|', pos);
+            size_t assign = line.find(TRACE_ASSIGN, end);
+            if (end == std::string::npos || assign == std::string::npos) {
+                continue;
+            }
+            std::string usecStr = line.substr(pos, end - pos);
+            size_t value;
+            if (!parseUnsigned(rtrim(usecStr, " \t"), value)) {
+                THROW_ERROR("Invalid time \"" << usecStr << "\" on line " << lineNo << " of trace file \"" << path << '"', __LINE__)
+            }
+            std::string left = line.substr(end + 1, assign - end - 1);
+            for (std::sregex_iterator iter(left.begin(), left.end(), TRACE_RESULT_VAR), iterEnd; iter != iterEnd; ++iter) {
+                if (iter->position() > 0 && left[iter->position() - 1] == ':') {
+                    continue; // type name, not a variable
+                }
+                usec[(*iter)[1]] = value;
+            }
+            for (std::sregex_iterator iter(line.begin() + end, line.end(), TRACE_VAR_ROWS), iterEnd; iter != iterEnd; ++iter) {
+                if (!parseUnsigned((*iter)[3], rows[(*iter)[1]])) {
+                    THROW_ERROR("Invalid row count \"" << (*iter)[3] << "\" on line " << lineNo << " of trace file \"" << path << '"', __LINE__)
+                }
+            }
+        }
+    }
+
+    bool trace_t::empty() const {
+        return usec.empty() && rows.empty();
+    }
+
+    size_t trace_t::costOf(
+            id_t nodeID) const {
+        size_t cost = 0;
+        auto range = nodeOut.equal_range(nodeID);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            auto itUsec = usec.find(idsToNames[iter->second]);
+            if (itUsec != usec.end()) {
+                cost = std::max(cost, itUsec->second);
+            }
+        }
+        return cost;
+    }
+
+    size_t trace_t::rowsOf(
+            id_t varID,
+            size_t defaultRows) const {
+        auto iter = rows.find(idsToNames[varID]);
+        return iter == rows.end() ? defaultRows : iter->second;
+    }
+
+}
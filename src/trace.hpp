@@ -0,0 +1,70 @@
+// Copyright 2026 agent
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * trace.hpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent - agent@local
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <map>
+
+#include "graph.hpp"
+
+namespace e2d {
+
+    /**
+     * Measurements imported from the output of MonetDB's TRACE statement for the same plan, e.g.
+     *
+     *   |  16 | X_5=[1000]:bat[:oid] := sql.tid(X_4=0:int,"sys":str,"t":str); |
+     *
+     * Measurements are keyed by the names of the instruction's result variables, which are identical to the ones in the EXPLAIN output.
+     * Cardinalities ("[1000]") are taken from results and arguments alike.
+     */
+    class trace_t {
+
+        std::map<std::string, size_t> usec;
+        std::map<std::string, size_t> rows;
+
+    public:
+        trace_t();
+
+        /**
+         * @throws std::runtime_error if the file cannot be read.
+         */
+        void load(
+                const std::string& path);
+
+        bool empty() const;
+
+        /**
+         * @return the execution time in microseconds of the instruction producing the given node's results, or 0 if unknown.
+         */
+        size_t costOf(
+                id_t nodeID) const;
+
+        /**
+         * @return the number of rows of the given BAT variable, or defaultRows if unknown.
+         */
+        size_t rowsOf(
+                id_t varID,
+                size_t defaultRows) const;
+    };
+
+}